@@ -0,0 +1,348 @@
+#!/usr/bin/env python3
+# Copyright (c) 2026 Golioth, Inc.
+# SPDX-License-Identifier: Apache-2.0
+
+"""Minimal CoAP over DTLS (PSK) server standing in for Golioth in fleet runs.
+
+DTLS is terminated by dtls_frontend.c, built from this directory with the
+host's mbedTLS 3.x on start (cc -lmbedtls -lmbedx509 -lmbedcrypto). It keeps
+a session cache and issues session tickets, so reconnecting devices resume
+their sessions with an abbreviated handshake, and negotiates DTLS Connection
+ID. Plaintext CoAP is relayed to this script over UDP on 127.0.0.1.
+
+Devices authenticate with the PSK-ID and PSK from the credentials file (one
+"psk-id,psk" line per device, the same file fleet_sim.py reads). Every request
+is acknowledged: writes with 2.04 Changed, reads and observations with
+2.05 Content and an empty map in the requested content format, and blockwise
+uploads with 2.31 Continue until their last block. The server never sends
+desired state, settings, RPCs or firmware manifests.
+
+Handshake counts from the front end and request and byte counts per service
+(the first path segment, e.g. ".s" for Stream or ".d" for LightDB State) are
+printed as JSON lines:
+
+    {"standin": {"uptime_s": 10.0, "sessions": 50, "handshakes": 100,
+                 "resumed_handshakes": 50, "cid_sessions": 100,
+                 "handshake_failures": 0, "requests": 812, "bytes_in": 30210,
+                 "services": {...}}}
+
+Example:
+
+    ./app/scripts/coap_standin.py --credentials devices.csv
+"""
+
+import argparse
+import json
+import os
+import shutil
+import signal
+import socket
+import struct
+import subprocess
+import sys
+import tempfile
+import threading
+import time
+from collections import defaultdict
+
+COAP_VERSION = 1
+TYPE_CON, TYPE_NON, TYPE_ACK, TYPE_RST = range(4)
+
+CODE_EMPTY = 0x00
+CODE_GET, CODE_POST, CODE_PUT, CODE_DELETE = 0x01, 0x02, 0x03, 0x04
+CODE_DELETED = 0x42
+CODE_CHANGED = 0x44
+CODE_CONTENT = 0x45
+CODE_CONTINUE = 0x5F
+CODE_BAD_REQUEST = 0x80
+
+OPT_OBSERVE = 6
+OPT_URI_PATH = 11
+OPT_CONTENT_FORMAT = 12
+OPT_ACCEPT = 17
+OPT_BLOCK1 = 27
+
+FORMAT_JSON = 50
+FORMAT_CBOR = 60
+EMPTY_MAPS = {FORMAT_JSON: b"{}", FORMAT_CBOR: b"\xa0"}
+
+FRONTEND_SRC = os.path.join(os.path.dirname(os.path.abspath(__file__)), "dtls_frontend.c")
+FRONTEND_LIBS = ["-lmbedtls", "-lmbedx509", "-lmbedcrypto"]
+FRONTEND_START_TIMEOUT_S = 10
+
+
+def read_credentials(path):
+    psks = {}
+    with open(path) as f:
+        for line in f:
+            line = line.strip()
+            if not line or line.startswith("#"):
+                continue
+            psk_id, psk = line.split(",", 1)
+            psks[psk_id.strip()] = psk.strip().encode()
+
+    return psks
+
+
+def decode_uint(value):
+    return int.from_bytes(value, "big") if value else 0
+
+
+def encode_uint(value):
+    return value.to_bytes((value.bit_length() + 7) // 8, "big")
+
+
+def parse(datagram):
+    """Split a CoAP message into its header fields, options and payload"""
+    if len(datagram) < 4:
+        raise ValueError("short header")
+
+    first, code, mid = struct.unpack("!BBH", datagram[:4])
+    if first >> 6 != COAP_VERSION:
+        raise ValueError("unknown version")
+
+    msg_type = (first >> 4) & 0x3
+    tkl = first & 0xF
+    token = datagram[4:4 + tkl]
+    pos = 4 + tkl
+    number = 0
+    options = []
+
+    while pos < len(datagram) and datagram[pos] != 0xFF:
+        delta, length = datagram[pos] >> 4, datagram[pos] & 0xF
+        pos += 1
+        values = []
+        for nibble in (delta, length):
+            if nibble == 13:
+                values.append(datagram[pos] + 13)
+                pos += 1
+            elif nibble == 14:
+                values.append(struct.unpack("!H", datagram[pos:pos + 2])[0] + 269)
+                pos += 2
+            elif nibble == 15:
+                raise ValueError("reserved option nibble")
+            else:
+                values.append(nibble)
+        number += values[0]
+        options.append((number, datagram[pos:pos + values[1]]))
+        pos += values[1]
+
+    payload = datagram[pos + 1:] if pos < len(datagram) else b""
+
+    return msg_type, code, mid, token, options, payload
+
+
+def build(msg_type, code, mid, token, options=(), payload=b""):
+    out = bytearray(struct.pack("!BBH", (COAP_VERSION << 6) | (msg_type << 4) | len(token),
+                                code, mid))
+    out += token
+    number = 0
+
+    for opt, value in sorted(options, key=lambda o: o[0]):
+        header = bytearray(1)
+        nibbles = []
+        for field in (opt - number, len(value)):
+            if field < 13:
+                nibbles.append(field)
+            elif field < 269:
+                nibbles.append(13)
+                header.append(field - 13)
+            else:
+                nibbles.append(14)
+                header += struct.pack("!H", field - 269)
+        header[0] = (nibbles[0] << 4) | nibbles[1]
+        out += header + value
+        number = opt
+
+    if payload:
+        out += b"\xff" + payload
+
+    return bytes(out)
+
+
+class Stats:
+    def __init__(self):
+        self.lock = threading.Lock()
+        self.t0 = time.monotonic()
+        # Counters of the DTLS front end
+        self.dtls = {"sessions": 0, "handshakes": 0, "resumed_handshakes": 0,
+                     "cid_sessions": 0, "handshake_failures": 0}
+        self.requests = 0
+        self.bytes_in = 0
+        self.services = defaultdict(lambda: {"requests": 0, "bytes": 0})
+
+    def count(self, service, payload_len):
+        with self.lock:
+            self.requests += 1
+            self.bytes_in += payload_len
+            self.services[service]["requests"] += 1
+            self.services[service]["bytes"] += payload_len
+
+    def snapshot(self):
+        with self.lock:
+            return {
+                "uptime_s": round(time.monotonic() - self.t0, 1),
+                **self.dtls,
+                "requests": self.requests,
+                "bytes_in": self.bytes_in,
+                "services": dict(self.services),
+            }
+
+
+def respond(datagram, mid_counter, stats):
+    """Return the response to one request, or None if none is due"""
+    try:
+        msg_type, code, mid, token, options, payload = parse(datagram)
+    except (ValueError, IndexError, struct.error):
+        return None
+
+    if msg_type in (TYPE_ACK, TYPE_RST):
+        return None
+
+    if code == CODE_EMPTY:
+        # CoAP ping, answered with a reset
+        return build(TYPE_RST, CODE_EMPTY, mid, b"") if msg_type == TYPE_CON else None
+
+    path = [v.decode(errors="replace") for n, v in options if n == OPT_URI_PATH]
+    stats.count(path[0] if path else "/", len(payload))
+
+    resp_options = []
+    resp_payload = b""
+    block1 = next((v for n, v in options if n == OPT_BLOCK1), None)
+    observe = next((v for n, v in options if n == OPT_OBSERVE), None)
+    accept = next((decode_uint(v) for n, v in options if n == OPT_ACCEPT), None)
+
+    if code == CODE_GET:
+        resp_code = CODE_CONTENT
+        if accept in EMPTY_MAPS:
+            resp_options.append((OPT_CONTENT_FORMAT, encode_uint(accept)))
+            resp_payload = EMPTY_MAPS[accept]
+        if observe is not None and decode_uint(observe) == 0:
+            resp_options.append((OPT_OBSERVE, encode_uint(2)))
+    elif code in (CODE_POST, CODE_PUT):
+        resp_code = CODE_CHANGED
+    elif code == CODE_DELETE:
+        resp_code = CODE_DELETED
+    else:
+        resp_code = CODE_BAD_REQUEST
+
+    if block1 is not None and code in (CODE_POST, CODE_PUT):
+        resp_options.append((OPT_BLOCK1, block1))
+        if decode_uint(block1) & 0x8:
+            resp_code = CODE_CONTINUE
+
+    if msg_type == TYPE_CON:
+        return build(TYPE_ACK, resp_code, mid, token, resp_options, resp_payload)
+
+    return build(TYPE_NON, resp_code, next(mid_counter) & 0xFFFF, token, resp_options,
+                 resp_payload)
+
+
+def build_frontend(workdir):
+    cc = os.environ.get("CC") or shutil.which("cc")
+    if not cc:
+        sys.exit("A C compiler is required to build the DTLS front end")
+
+    exe = os.path.join(workdir, "dtls_frontend")
+    result = subprocess.run([cc, "-O2", "-o", exe, FRONTEND_SRC, *FRONTEND_LIBS],
+                            capture_output=True, text=True)
+    if result.returncode:
+        sys.exit("Failed to build the DTLS front end (mbedTLS 3.x development files "
+                 f"are required):\n{result.stderr}")
+
+    return exe
+
+
+class Frontend:
+    """DTLS front end process, relaying each session to the CoAP socket"""
+
+    def __init__(self, exe, args, coap_port, stats):
+        self.stats = stats
+        self.listening = threading.Event()
+        self.proc = subprocess.Popen([exe, args.credentials, args.bind, str(args.port),
+                                      str(coap_port), str(max(1, int(args.report_interval_s)))],
+                                     stdout=subprocess.PIPE, text=True, errors="replace")
+        self.reader = threading.Thread(target=self._read, daemon=True)
+        self.reader.start()
+
+        if not self.listening.wait(FRONTEND_START_TIMEOUT_S):
+            self.stop()
+            sys.exit("DTLS front end failed to start")
+
+    def _read(self):
+        for line in self.proc.stdout:
+            try:
+                obj = json.loads(line)
+            except json.JSONDecodeError:
+                continue
+
+            if "dtls_listening" in obj:
+                self.listening.set()
+            elif "dtls" in obj:
+                with self.stats.lock:
+                    self.stats.dtls.update(obj["dtls"])
+
+    def stop(self):
+        self.proc.terminate()
+        try:
+            self.proc.wait(timeout=5)
+        except subprocess.TimeoutExpired:
+            self.proc.kill()
+        self.reader.join(timeout=5)
+
+
+def serve(sock, stats):
+    """Answer the plaintext CoAP relayed by the front end, one source port per session"""
+    mid_counter = iter(range(1, 1 << 62))
+
+    while True:
+        datagram, addr = sock.recvfrom(4096)
+        response = respond(datagram, mid_counter, stats)
+        if response:
+            sock.sendto(response, addr)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--credentials", required=True,
+                        help="file with one 'psk-id,psk' line per device")
+    parser.add_argument("--bind", default="127.0.0.1", help="address to listen on")
+    parser.add_argument("--port", type=int, default=5684, help="UDP port to listen on")
+    parser.add_argument("--report-interval-s", type=float, default=10,
+                        help="interval between statistics lines")
+    args = parser.parse_args()
+
+    def on_sigterm(signum, frame):
+        raise KeyboardInterrupt
+
+    # fleet_sim.py stops the stand-in with SIGTERM, print the final line then too
+    signal.signal(signal.SIGTERM, on_sigterm)
+
+    if not read_credentials(args.credentials):
+        sys.exit(f"No credentials in {args.credentials}")
+
+    sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+    sock.bind(("127.0.0.1", 0))
+
+    stats = Stats()
+    threading.Thread(target=serve, args=(sock, stats), daemon=True).start()
+
+    with tempfile.TemporaryDirectory(prefix="coap_standin_") as workdir:
+        frontend = Frontend(build_frontend(workdir), args, sock.getsockname()[1], stats)
+        print(json.dumps({"standin_listening": f"{args.bind}:{args.port}"}), flush=True)
+
+        try:
+            while frontend.proc.poll() is None:
+                time.sleep(args.report_interval_s)
+                print(json.dumps({"standin": stats.snapshot()}), flush=True)
+        except KeyboardInterrupt:
+            pass
+        finally:
+            # The front end prints its final counters on exit
+            frontend.stop()
+            print(json.dumps({"standin": stats.snapshot()}), flush=True)
+
+
+if __name__ == "__main__":
+    main()
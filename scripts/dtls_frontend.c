@@ -0,0 +1,603 @@
+/*
+ * Copyright (c) 2026 Golioth, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * DTLS front end of coap_standin.py, built and started by it.
+ *
+ * Terminates DTLS 1.2 (PSK) sessions with the same stack the devices use and
+ * relays the plaintext CoAP messages of each session over UDP to the stand-in
+ * on 127.0.0.1, from a socket of its own so the stand-in can tell sessions
+ * apart. Unlike a bare DTLS server it supports what reconnecting devices rely
+ * on:
+ *
+ * - session resumption from a server side session cache and from session
+ *   tickets, so a reconnect within the ticket lifetime is an abbreviated
+ *   handshake
+ * - DTLS Connection ID (RFC 9146), when mbedTLS is built with
+ *   MBEDTLS_SSL_DTLS_CONNECTION_ID
+ * - HelloVerifyRequest cookies and client port reuse
+ *
+ * Runs in a single thread. Counters are printed as JSON lines:
+ *
+ *   {"dtls": {"sessions": 50, "handshakes": 100, "resumed_handshakes": 50,
+ *             "cid_sessions": 100, "handshake_failures": 0}}
+ *
+ * Requires mbedTLS 3.x:
+ *
+ *   cc -O2 -o dtls_frontend dtls_frontend.c -lmbedtls -lmbedx509 -lmbedcrypto
+ *   ./dtls_frontend <credentials> <bind address> <port> <stand-in port> <report interval s>
+ */
+
+#include <errno.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+#include <mbedtls/ctr_drbg.h>
+#include <mbedtls/entropy.h>
+#include <mbedtls/net_sockets.h>
+#include <mbedtls/ssl.h>
+#include <mbedtls/ssl_cache.h>
+#include <mbedtls/ssl_cookie.h>
+#include <mbedtls/ssl_ticket.h>
+#include <mbedtls/timing.h>
+#include <mbedtls/version.h>
+
+#if MBEDTLS_VERSION_MAJOR < 3
+#error "mbedTLS 3.x is required"
+#endif
+
+#define MAX_SESSIONS 1024
+#define MAX_PSK_LEN 64
+#define CID_LEN 8
+#define DATAGRAM_MAX_LEN 2048
+#define POLL_INTERVAL_MS 50
+#define SESSION_IDLE_TIMEOUT_S 600
+#define HANDSHAKE_TIMEOUT_S 60
+#define TICKET_LIFETIME_S 86400
+
+struct psk_entry {
+	char *id;
+	unsigned char key[MAX_PSK_LEN];
+	size_t key_len;
+};
+
+struct session {
+	bool used;
+	bool established;
+	bool resumed;
+	mbedtls_net_context client;
+	int backend;
+	mbedtls_ssl_context ssl;
+	mbedtls_timing_delay_context timer;
+	time_t last_active;
+};
+
+static struct psk_entry *psks;
+static size_t psk_count;
+
+static struct session sessions[MAX_SESSIONS];
+/* Session whose handshake is being processed, for the resumption callbacks */
+static struct session *current;
+
+static struct {
+	unsigned int sessions;
+	unsigned int handshakes;
+	unsigned int resumed_handshakes;
+	unsigned int cid_sessions;
+	unsigned int handshake_failures;
+} stats;
+
+static mbedtls_entropy_context entropy;
+static mbedtls_ctr_drbg_context drbg;
+static mbedtls_ssl_config conf;
+static mbedtls_ssl_cookie_ctx cookie;
+static mbedtls_ssl_cache_context cache;
+static mbedtls_ssl_ticket_context ticket;
+
+static struct sockaddr_in backend_addr;
+static volatile sig_atomic_t stopping;
+
+static void on_signal(int sig)
+{
+	stopping = 1;
+}
+
+static int read_credentials(const char *path)
+{
+	char line[512];
+	FILE *f = fopen(path, "r");
+
+	if (!f) {
+		perror(path);
+		return -1;
+	}
+
+	while (fgets(line, sizeof(line), f)) {
+		char *comma = strchr(line, ',');
+		char *end;
+
+		line[strcspn(line, "\r\n")] = '\0';
+		if ((line[0] == '\0') || (line[0] == '#') || !comma) {
+			continue;
+		}
+
+		*comma = '\0';
+
+		/* Trim around the separator, as coap_standin.py does */
+		for (end = comma - 1; (end >= line) && (*end == ' '); end--) {
+			*end = '\0';
+		}
+		char *key = comma + 1;
+
+		while (*key == ' ') {
+			key++;
+		}
+		for (end = key + strlen(key) - 1; (end >= key) && (*end == ' '); end--) {
+			*end = '\0';
+		}
+
+		if (strlen(key) > MAX_PSK_LEN) {
+			fprintf(stderr, "PSK of %s longer than %d bytes\n", line, MAX_PSK_LEN);
+			continue;
+		}
+
+		struct psk_entry *grown = realloc(psks, (psk_count + 1) * sizeof(*psks));
+
+		if (!grown) {
+			fclose(f);
+			return -1;
+		}
+
+		psks = grown;
+		psks[psk_count].id = strdup(line);
+		psks[psk_count].key_len = strlen(key);
+		memcpy(psks[psk_count].key, key, psks[psk_count].key_len);
+		psk_count++;
+	}
+
+	fclose(f);
+
+	return 0;
+}
+
+static int psk_cb(void *arg, mbedtls_ssl_context *ssl, const unsigned char *id, size_t id_len)
+{
+	for (size_t i = 0; i < psk_count; i++) {
+		if ((strlen(psks[i].id) == id_len) && (memcmp(psks[i].id, id, id_len) == 0)) {
+			return mbedtls_ssl_set_hs_psk(ssl, psks[i].key, psks[i].key_len);
+		}
+	}
+
+	return -1;
+}
+
+/* A session found in the cache or a valid ticket means the handshake resumes */
+static int cache_get(void *data, unsigned char const *session_id, size_t session_id_len,
+		     mbedtls_ssl_session *session)
+{
+	int ret = mbedtls_ssl_cache_get(data, session_id, session_id_len, session);
+
+	if ((ret == 0) && current) {
+		current->resumed = true;
+	}
+
+	return ret;
+}
+
+static int ticket_parse(void *p_ticket, mbedtls_ssl_session *session, unsigned char *buf,
+			size_t len)
+{
+	int ret = mbedtls_ssl_ticket_parse(p_ticket, session, buf, len);
+
+	if ((ret == 0) && current) {
+		current->resumed = true;
+	}
+
+	return ret;
+}
+
+static void print_stats(void)
+{
+	printf("{\"dtls\": {\"sessions\": %u, \"handshakes\": %u, \"resumed_handshakes\": %u, "
+	       "\"cid_sessions\": %u, \"handshake_failures\": %u}}\n",
+	       stats.sessions, stats.handshakes, stats.resumed_handshakes, stats.cid_sessions,
+	       stats.handshake_failures);
+	fflush(stdout);
+}
+
+static void session_close(struct session *s, bool notify)
+{
+	if (notify && s->established) {
+		mbedtls_ssl_close_notify(&s->ssl);
+	}
+
+	if (s->established) {
+		stats.sessions--;
+	}
+
+	if (s->backend >= 0) {
+		close(s->backend);
+		s->backend = -1;
+	}
+
+	mbedtls_net_free(&s->client);
+	mbedtls_ssl_session_reset(&s->ssl);
+	s->used = false;
+	s->established = false;
+	s->resumed = false;
+}
+
+static int session_open_backend(struct session *s)
+{
+	s->backend = socket(AF_INET, SOCK_DGRAM, 0);
+	if (s->backend < 0) {
+		return -errno;
+	}
+
+	if (connect(s->backend, (struct sockaddr *)&backend_addr, sizeof(backend_addr)) < 0) {
+		return -errno;
+	}
+
+	return 0;
+}
+
+static void session_handshake(struct session *s)
+{
+	current = s;
+	int ret = mbedtls_ssl_handshake(&s->ssl);
+	current = NULL;
+
+	if ((ret == MBEDTLS_ERR_SSL_WANT_READ) || (ret == MBEDTLS_ERR_SSL_WANT_WRITE)) {
+		return;
+	}
+
+	if (ret == MBEDTLS_ERR_SSL_HELLO_VERIFY_REQUIRED) {
+		/* The client repeats its ClientHello with the cookie */
+		session_close(s, false);
+		return;
+	}
+
+	if (ret != 0) {
+		stats.handshake_failures++;
+		session_close(s, false);
+		return;
+	}
+
+	if (session_open_backend(s) < 0) {
+		perror("backend socket");
+		session_close(s, false);
+		return;
+	}
+
+	s->established = true;
+	s->last_active = time(NULL);
+	stats.sessions++;
+	stats.handshakes++;
+	if (s->resumed) {
+		stats.resumed_handshakes++;
+	}
+
+#if defined(MBEDTLS_SSL_DTLS_CONNECTION_ID)
+	int cid_enabled = MBEDTLS_SSL_CID_DISABLED;
+
+	if ((mbedtls_ssl_get_peer_cid(&s->ssl, &cid_enabled, NULL, NULL) == 0) &&
+	    (cid_enabled == MBEDTLS_SSL_CID_ENABLED)) {
+		stats.cid_sessions++;
+	}
+#endif
+}
+
+/* Device to stand-in */
+static void session_relay_in(struct session *s)
+{
+	unsigned char buf[DATAGRAM_MAX_LEN];
+
+	while (true) {
+		int ret = mbedtls_ssl_read(&s->ssl, buf, sizeof(buf));
+
+		if (ret > 0) {
+			send(s->backend, buf, ret, 0);
+			s->last_active = time(NULL);
+			continue;
+		}
+
+		if ((ret == MBEDTLS_ERR_SSL_WANT_READ) || (ret == MBEDTLS_ERR_SSL_WANT_WRITE)) {
+			return;
+		}
+
+		if (ret == MBEDTLS_ERR_SSL_CLIENT_RECONNECT) {
+			/* New handshake from the same port, the context was reset for it */
+			stats.sessions--;
+			close(s->backend);
+			s->backend = -1;
+			s->established = false;
+			s->resumed = false;
+			session_handshake(s);
+			return;
+		}
+
+		/* Close notify or a fatal error */
+		session_close(s, ret == 0);
+		return;
+	}
+}
+
+/* Stand-in to device */
+static void session_relay_out(struct session *s)
+{
+	unsigned char buf[DATAGRAM_MAX_LEN];
+	ssize_t len;
+
+	while ((len = recv(s->backend, buf, sizeof(buf), MSG_DONTWAIT)) > 0) {
+		/* A datagram that cannot be sent right away is lost, as on the network */
+		mbedtls_ssl_write(&s->ssl, buf, len);
+	}
+}
+
+static void session_accept(mbedtls_net_context *listen_ctx)
+{
+	unsigned char client_ip[16];
+	size_t client_ip_len;
+	struct session *s = NULL;
+
+	for (int i = 0; i < MAX_SESSIONS; i++) {
+		if (!sessions[i].used) {
+			s = &sessions[i];
+			break;
+		}
+	}
+
+	mbedtls_net_context client;
+
+	mbedtls_net_init(&client);
+
+	/* Connects the listening socket to the client and binds a new one */
+	if (mbedtls_net_accept(listen_ctx, &client, client_ip, sizeof(client_ip),
+			       &client_ip_len) != 0) {
+		return;
+	}
+
+	if (!s) {
+		fprintf(stderr, "More than %d sessions, dropping\n", MAX_SESSIONS);
+		mbedtls_net_free(&client);
+		return;
+	}
+
+	s->used = true;
+	s->client = client;
+	s->backend = -1;
+	s->last_active = time(NULL);
+	mbedtls_net_set_nonblock(&s->client);
+	mbedtls_ssl_set_bio(&s->ssl, &s->client, mbedtls_net_send, mbedtls_net_recv, NULL);
+	mbedtls_ssl_set_client_transport_id(&s->ssl, client_ip, client_ip_len);
+
+#if defined(MBEDTLS_SSL_DTLS_CONNECTION_ID)
+	unsigned char cid[CID_LEN];
+
+	mbedtls_ctr_drbg_random(&drbg, cid, sizeof(cid));
+	mbedtls_ssl_set_cid(&s->ssl, MBEDTLS_SSL_CID_ENABLED, cid, sizeof(cid));
+#endif
+
+	session_handshake(s);
+}
+
+static int setup(void)
+{
+	int ret;
+
+	mbedtls_entropy_init(&entropy);
+	mbedtls_ctr_drbg_init(&drbg);
+	mbedtls_ssl_config_init(&conf);
+	mbedtls_ssl_cookie_init(&cookie);
+	mbedtls_ssl_cache_init(&cache);
+	mbedtls_ssl_ticket_init(&ticket);
+
+	ret = mbedtls_ctr_drbg_seed(&drbg, mbedtls_entropy_func, &entropy, NULL, 0);
+	if (ret) {
+		return ret;
+	}
+
+	ret = mbedtls_ssl_config_defaults(&conf, MBEDTLS_SSL_IS_SERVER,
+					  MBEDTLS_SSL_TRANSPORT_DATAGRAM,
+					  MBEDTLS_SSL_PRESET_DEFAULT);
+	if (ret) {
+		return ret;
+	}
+
+	mbedtls_ssl_conf_rng(&conf, mbedtls_ctr_drbg_random, &drbg);
+	mbedtls_ssl_conf_psk_cb(&conf, psk_cb, NULL);
+
+	ret = mbedtls_ssl_cookie_setup(&cookie, mbedtls_ctr_drbg_random, &drbg);
+	if (ret) {
+		return ret;
+	}
+	mbedtls_ssl_conf_dtls_cookies(&conf, mbedtls_ssl_cookie_write, mbedtls_ssl_cookie_check,
+				      &cookie);
+
+	mbedtls_ssl_cache_set_max_entries(&cache, MAX_SESSIONS);
+	mbedtls_ssl_conf_session_cache(&conf, &cache, cache_get, mbedtls_ssl_cache_set);
+
+	ret = mbedtls_ssl_ticket_setup(&ticket, mbedtls_ctr_drbg_random, &drbg,
+				       MBEDTLS_CIPHER_AES_256_GCM, TICKET_LIFETIME_S);
+	if (ret) {
+		return ret;
+	}
+	mbedtls_ssl_conf_session_tickets_cb(&conf, mbedtls_ssl_ticket_write, ticket_parse,
+					    &ticket);
+
+#if defined(MBEDTLS_SSL_DTLS_CONNECTION_ID)
+	ret = mbedtls_ssl_conf_cid(&conf, CID_LEN, MBEDTLS_SSL_UNEXPECTED_CID_IGNORE);
+	if (ret) {
+		return ret;
+	}
+#endif
+
+	for (int i = 0; i < MAX_SESSIONS; i++) {
+		struct session *s = &sessions[i];
+
+		mbedtls_net_init(&s->client);
+		mbedtls_ssl_init(&s->ssl);
+		s->backend = -1;
+
+		ret = mbedtls_ssl_setup(&s->ssl, &conf);
+		if (ret) {
+			return ret;
+		}
+
+		mbedtls_ssl_set_timer_cb(&s->ssl, &s->timer, mbedtls_timing_set_delay,
+					 mbedtls_timing_get_delay);
+	}
+
+	return 0;
+}
+
+int main(int argc, char **argv)
+{
+	static struct pollfd fds[1 + 2 * MAX_SESSIONS];
+	static struct session *fd_sessions[1 + 2 * MAX_SESSIONS];
+	mbedtls_net_context listen_ctx;
+	time_t last_report;
+	int ret;
+
+	if (argc != 6) {
+		fprintf(stderr, "usage: %s credentials bind port standin_port report_interval_s\n",
+			argv[0]);
+		return 2;
+	}
+
+	int report_interval_s = atoi(argv[5]);
+
+	if (read_credentials(argv[1]) < 0) {
+		return 1;
+	}
+
+	ret = setup();
+	if (ret) {
+		fprintf(stderr, "mbedTLS setup failed: -0x%04x\n", (unsigned int)-ret);
+		return 1;
+	}
+
+	backend_addr.sin_family = AF_INET;
+	backend_addr.sin_port = htons(atoi(argv[4]));
+	backend_addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+	mbedtls_net_init(&listen_ctx);
+	ret = mbedtls_net_bind(&listen_ctx, argv[2], argv[3], MBEDTLS_NET_PROTO_UDP);
+	if (ret) {
+		fprintf(stderr, "Failed to bind %s:%s: -0x%04x\n", argv[2], argv[3],
+			(unsigned int)-ret);
+		return 1;
+	}
+
+	signal(SIGTERM, on_signal);
+	signal(SIGINT, on_signal);
+
+	printf("{\"dtls_listening\": \"%s:%s\"}\n", argv[2], argv[3]);
+	fflush(stdout);
+	last_report = time(NULL);
+
+	while (!stopping) {
+		nfds_t nfds = 0;
+
+		/* mbedtls_net_accept() replaces the listening socket */
+		fds[nfds].fd = listen_ctx.fd;
+		fds[nfds].events = POLLIN;
+		fd_sessions[nfds++] = NULL;
+
+		for (int i = 0; i < MAX_SESSIONS; i++) {
+			struct session *s = &sessions[i];
+
+			if (!s->used) {
+				continue;
+			}
+
+			fds[nfds].fd = s->client.fd;
+			fds[nfds].events = POLLIN;
+			fd_sessions[nfds++] = s;
+
+			if (s->established) {
+				fds[nfds].fd = s->backend;
+				fds[nfds].events = POLLIN;
+				fd_sessions[nfds++] = s;
+			}
+		}
+
+		if (poll(fds, nfds, POLL_INTERVAL_MS) < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			perror("poll");
+			return 1;
+		}
+
+		for (nfds_t i = 1; i < nfds; i++) {
+			struct session *s = fd_sessions[i];
+
+			if (!s->used || !(fds[i].revents & (POLLIN | POLLERR))) {
+				continue;
+			}
+
+			if (fds[i].fd == s->client.fd) {
+				if (s->established) {
+					session_relay_in(s);
+				} else {
+					session_handshake(s);
+				}
+			} else if (s->established && (fds[i].fd == s->backend)) {
+				session_relay_out(s);
+			}
+		}
+
+		time_t now = time(NULL);
+
+		for (int i = 0; i < MAX_SESSIONS; i++) {
+			struct session *s = &sessions[i];
+
+			if (!s->used) {
+				continue;
+			}
+
+			if (!s->established && (now - s->last_active > HANDSHAKE_TIMEOUT_S)) {
+				stats.handshake_failures++;
+				session_close(s, false);
+			} else if (!s->established && (mbedtls_timing_get_delay(&s->timer) == 2)) {
+				/* Handshake retransmission timer expired */
+				session_handshake(s);
+			} else if (s->established &&
+				   (now - s->last_active > SESSION_IDLE_TIMEOUT_S)) {
+				session_close(s, true);
+			}
+		}
+
+		if (fds[0].revents & POLLIN) {
+			session_accept(&listen_ctx);
+		}
+
+		if (now - last_report >= report_interval_s) {
+			print_stats();
+			last_report = now;
+		}
+	}
+
+	for (int i = 0; i < MAX_SESSIONS; i++) {
+		if (sessions[i].used) {
+			session_close(&sessions[i], true);
+		}
+	}
+
+	print_stats();
+
+	return 0;
+}
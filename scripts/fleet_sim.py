@@ -0,0 +1,320 @@
+#!/usr/bin/env python3
+# Copyright (c) 2026 Golioth, Inc.
+# SPDX-License-Identifier: Apache-2.0
+
+"""Run many native_sim instances of the firmware as a simulated fleet.
+
+Each instance gets its own credentials (one "psk-id,psk" line per device in
+the credentials file) and its own flash file for settings. Instances print
+connection events, uplink counters and the simulated radio's charge as JSON
+lines (see src/app_fleet_sim.h and src/app_link_sim.h), which are aggregated
+into messages/s, bytes/s, reconnect storms, latency percentiles and average
+radio current once the run ends. Running the same scenario with and without
+--txwin-period-s shows the energy and latency trade-off of transmit windows.
+
+By default the fleet talks to the local stand-in server in coap_standin.py,
+which native_sim builds target (coaps://127.0.0.1, see boards/native_sim.conf).
+Pass --server external to leave the server to the caller, e.g. after building
+with another CONFIG_GOLIOTH_COAP_HOST_URI.
+
+Example:
+
+    west build -p -b native_sim app --no-sysbuild
+    ./app/scripts/fleet_sim.py --exe build/zephyr/zephyr.exe \\
+        --credentials devices.csv --count 50 --duration-s 600 \\
+        --start-jitter-ms 5000 --link-down-at-s 300 --link-down-for-s 60
+"""
+
+import argparse
+import json
+import os
+import subprocess
+import sys
+import tempfile
+import threading
+import time
+from collections import Counter
+
+CLASSES = ("urgent", "state", "bulk")
+STANDIN = os.path.join(os.path.dirname(os.path.abspath(__file__)), "coap_standin.py")
+# Includes building the DTLS front end
+STANDIN_START_TIMEOUT_S = 60
+
+
+def read_credentials(path, count):
+    creds = []
+    with open(path) as f:
+        for line in f:
+            line = line.strip()
+            if not line or line.startswith("#"):
+                continue
+            psk_id, psk = line.split(",", 1)
+            creds.append((psk_id.strip(), psk.strip()))
+
+    if len(creds) < count:
+        sys.exit(f"{path} holds {len(creds)} credentials, {count} needed")
+
+    return creds[:count]
+
+
+def instance_args(args, index, psk_id, psk, workdir):
+    cmd = [
+        args.exe,
+        f"--flash={os.path.join(workdir, f'device_{index}.bin')}",
+        f"--psk-id={psk_id}",
+        f"--psk={psk}",
+    ]
+
+    if args.loop_delay_s:
+        cmd.append(f"--loop-delay-s={args.loop_delay_s}")
+    if args.start_jitter_ms:
+        cmd.append(f"--start-jitter-ms={args.start_jitter_ms}")
+    if args.link_down_at_s is not None:
+        cmd.append(f"--link-down-at-s={args.link_down_at_s}")
+        cmd.append(f"--link-down-for-s={args.link_down_for_s}")
+        if args.link_down_period_s:
+            cmd.append(f"--link-down-period-s={args.link_down_period_s}")
+    if args.txwin_period_s is not None:
+        cmd.append(f"--txwin-period-s={args.txwin_period_s}")
+    if args.link_tail_ms is not None:
+        cmd.append(f"--link-tail-ms={args.link_tail_ms}")
+    if args.link_tau_s is not None:
+        cmd.append(f"--link-tau-s={args.link_tau_s}")
+
+    return cmd
+
+
+class Instance:
+    def __init__(self, index, cmd, t0):
+        self.index = index
+        self.t0 = t0
+        self.events = []
+        self.report = None
+        self.link = None
+        self.proc = subprocess.Popen(cmd, stdout=subprocess.PIPE,
+                                     stderr=subprocess.STDOUT, text=True,
+                                     errors="replace")
+        self.reader = threading.Thread(target=self._read, daemon=True)
+        self.reader.start()
+
+    def _read(self):
+        for line in self.proc.stdout:
+            line = line.strip()
+            if not line.startswith("{"):
+                continue
+            try:
+                obj = json.loads(line)
+            except json.JSONDecodeError:
+                continue
+
+            if "fleet_event" in obj:
+                self.events.append((time.monotonic() - self.t0, obj["fleet_event"]))
+            elif "fleet" in obj:
+                self.report = obj["fleet"]
+            elif "link" in obj:
+                self.link = obj["link"]
+
+    def stop(self):
+        self.proc.terminate()
+        try:
+            self.proc.wait(timeout=5)
+        except subprocess.TimeoutExpired:
+            self.proc.kill()
+        self.reader.join(timeout=5)
+
+
+class Standin:
+    """Local CoAP/DTLS server the instances connect to"""
+
+    def __init__(self, credentials):
+        self.stats = None
+        self.listening = threading.Event()
+        self.proc = subprocess.Popen([sys.executable, STANDIN, "--credentials", credentials],
+                                     stdout=subprocess.PIPE, text=True, errors="replace")
+        self.reader = threading.Thread(target=self._read, daemon=True)
+        self.reader.start()
+
+        if not self.listening.wait(STANDIN_START_TIMEOUT_S):
+            self.stop()
+            sys.exit("Stand-in server failed to start")
+
+    def _read(self):
+        for line in self.proc.stdout:
+            try:
+                obj = json.loads(line)
+            except json.JSONDecodeError:
+                continue
+
+            if "standin_listening" in obj:
+                self.listening.set()
+            elif "standin" in obj:
+                self.stats = obj["standin"]
+
+    def stop(self):
+        self.proc.terminate()
+        try:
+            self.proc.wait(timeout=5)
+        except subprocess.TimeoutExpired:
+            self.proc.kill()
+        self.reader.join(timeout=5)
+
+
+def percentile_ms(hist, fraction):
+    """Upper bound of the histogram bucket holding the given fraction"""
+    total = sum(hist)
+    if total == 0:
+        return None
+
+    running = 0
+    for bucket, count in enumerate(hist):
+        running += count
+        if running >= fraction * total:
+            return 2 ** bucket if bucket < len(hist) - 1 else float("inf")
+
+    return float("inf")
+
+
+def summarize(instances, elapsed_s):
+    summary = {"instances": len(instances), "elapsed_s": round(elapsed_s, 1)}
+    reports = [i.report for i in instances if i.report]
+    summary["reporting_instances"] = len(reports)
+
+    total_sent = 0
+    total_bytes = 0
+    classes = {}
+    for name in CLASSES:
+        sent = sum(r[name]["sent"] for r in reports)
+        sent_bytes = sum(r[name]["bytes"] for r in reports)
+        hist = [sum(col) for col in zip(*(r[name]["hist"] for r in reports))]
+        total_sent += sent
+        total_bytes += sent_bytes
+        classes[name] = {
+            "sent": sent,
+            "failed": sum(r[name]["failed"] for r in reports),
+            "dropped": sum(r[name]["dropped"] for r in reports),
+            "bytes": sent_bytes,
+            "latency_p50_ms": percentile_ms(hist, 0.50) if hist else None,
+            "latency_p95_ms": percentile_ms(hist, 0.95) if hist else None,
+            "latency_p99_ms": percentile_ms(hist, 0.99) if hist else None,
+        }
+
+    summary["messages_per_s"] = round(total_sent / elapsed_s, 2)
+    summary["bytes_per_s"] = round(total_bytes / elapsed_s, 2)
+    summary["classes"] = classes
+
+    # A reconnect is any connection after the first one of an instance
+    connects = [[t for t, e in i.events if e == "connected"] for i in instances]
+    reconnects = sorted(t for c in connects for t in c[1:])
+    per_second = Counter(int(t) for t in reconnects)
+    summary["connects"] = sum(len(c) for c in connects)
+    summary["reconnects"] = len(reconnects)
+    summary["disconnects"] = sum(r["disconnects"] for r in reports)
+
+    handshakes = [r["handshakes"] for r in reports]
+    summary["handshakes"] = {
+        kind: sum(h[kind] for h in handshakes)
+        for kind in ("full", "abbreviated", "unclassified", "failed")
+    }
+    for kind in ("full", "abbreviated"):
+        weighted = sum(h[f"{kind}_avg_ms"] * h[kind] for h in handshakes)
+        count = summary["handshakes"][kind]
+        summary["handshakes"][f"{kind}_avg_ms"] = round(weighted / count) if count else None
+    if per_second:
+        peak_second, peak = per_second.most_common(1)[0]
+        summary["reconnect_peak_per_s"] = peak
+        summary["reconnect_peak_at_s"] = peak_second
+    else:
+        summary["reconnect_peak_per_s"] = 0
+
+    links = [i.link for i in instances if i.link]
+    if links:
+        uptime_ms = sum(link["uptime_ms"] for link in links)
+        summary["radio"] = {
+            "avg_ua": round(sum(link["avg_ua"] for link in links) / len(links), 1),
+            "charge_uah_per_device": round(
+                sum(link["charge_uah"] for link in links) / len(links), 1),
+            "connected_fraction": round(
+                sum(link["connected_ms"] for link in links) / uptime_ms, 3),
+            "promotions_per_device_h": round(
+                sum(link["promotions"] for link in links) * 3600000 / uptime_ms, 1),
+            "windows": sum(link["windows"] for link in links),
+            "piggybacked": sum(link["piggybacked"] for link in links),
+        }
+
+    return summary
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--exe", required=True, help="native_sim zephyr.exe")
+    parser.add_argument("--credentials", required=True,
+                        help="file with one 'psk-id,psk' line per device")
+    parser.add_argument("--count", type=int, default=10, help="number of instances")
+    parser.add_argument("--duration-s", type=int, default=300, help="length of the run")
+    parser.add_argument("--loop-delay-s", type=int, help="initial LOOP_DELAY_S")
+    parser.add_argument("--start-jitter-ms", type=int, default=0,
+                        help="maximum random start delay of each instance")
+    parser.add_argument("--link-down-at-s", type=int,
+                        help="uptime at which every instance loses connectivity")
+    parser.add_argument("--link-down-for-s", type=int, default=30,
+                        help="duration of the connectivity loss")
+    parser.add_argument("--link-down-period-s", type=int,
+                        help="repeat the connectivity loss with this period")
+    parser.add_argument("--txwin-period-s", type=int,
+                        help="transmit window period, 0 sends without windows")
+    parser.add_argument("--link-tail-ms", type=int,
+                        help="RRC inactivity timer of the simulated network")
+    parser.add_argument("--link-tau-s", type=int,
+                        help="period of network initiated radio wake-ups")
+    parser.add_argument("--server", choices=("standin", "external"), default="standin",
+                        help="start the local stand-in server on 127.0.0.1:5684, or "
+                        "use the server the firmware was built for")
+    parser.add_argument("--expect-resumption", action="store_true",
+                        help="fail unless every reconnect resumed its DTLS session "
+                        "(use with --link-down-at-s)")
+    parser.add_argument("--output", help="write the JSON summary to this file")
+    args = parser.parse_args()
+
+    creds = read_credentials(args.credentials, args.count)
+    standin = Standin(args.credentials) if args.server == "standin" else None
+
+    with tempfile.TemporaryDirectory(prefix="fleet_sim_") as workdir:
+        t0 = time.monotonic()
+        instances = [Instance(i, instance_args(args, i, psk_id, psk, workdir), t0)
+                     for i, (psk_id, psk) in enumerate(creds)]
+
+        try:
+            time.sleep(args.duration_s)
+        except KeyboardInterrupt:
+            pass
+
+        elapsed_s = time.monotonic() - t0
+        for instance in instances:
+            instance.stop()
+
+    summary = summarize(instances, elapsed_s)
+    if standin:
+        # The final statistics line is printed on exit
+        standin.stop()
+        summary["server"] = standin.stats
+
+    handshakes = summary["handshakes"]
+    text = json.dumps(summary, indent=2)
+    print(text)
+    if args.output:
+        with open(args.output, "w") as f:
+            f.write(text + "\n")
+
+    # The first connect of each instance has no session to resume
+    if args.expect_resumption and (handshakes["failed"] or handshakes["unclassified"] or
+                                   handshakes["abbreviated"] == 0 or
+                                   handshakes["full"] > summary["reporting_instances"]):
+        sys.exit("Not every reconnect resumed its DTLS session")
+
+    if args.expect_resumption and standin and not (standin.stats or {}).get("resumed_handshakes"):
+        sys.exit("The stand-in server did not resume any DTLS session")
+
+
+if __name__ == "__main__":
+    main()
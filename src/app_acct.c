@@ -0,0 +1,450 @@
+/*
+ * Copyright (c) 2026 Golioth, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(app_acct, LOG_LEVEL_DBG);
+
+#include <errno.h>
+#include <string.h>
+#include <golioth/client.h>
+#include <zcbor_encode.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log_backend.h>
+#include <zephyr/logging/log_ctrl.h>
+#include <zephyr/logging/log_msg.h>
+#include <zephyr/spinlock.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/zbus/zbus.h>
+
+#include "app_acct.h"
+#include "app_bus.h"
+#include "app_uplink.h"
+
+#define ACCT_PATH "accounting"
+#define GOLIOTH_LOG_BACKEND_NAME "log_backend_golioth"
+
+/* Charge is accumulated in uA*ms */
+#define UAMS_PER_UAH (3600 * MSEC_PER_SEC)
+
+struct acct_counters {
+	atomic_t tx_msgs;
+	atomic_t tx_bytes;
+	atomic_t rx_msgs;
+	atomic_t rx_bytes;
+};
+
+static struct acct_counters counters[APP_ACCT_SUBSYSTEM_COUNT];
+
+static const char *const subsystem_names[APP_ACCT_SUBSYSTEM_COUNT] = {
+	[APP_ACCT_STREAM] = "stream",
+	[APP_ACCT_STATE] = "state",
+	[APP_ACCT_RPC] = "rpc",
+	[APP_ACCT_SETTINGS] = "settings",
+	[APP_ACCT_LOGS] = "logs",
+	[APP_ACCT_OTA] = "ota",
+};
+
+static uint64_t radio_connected_ms;
+static int64_t radio_connected_since = -1;
+static struct k_spinlock lock;
+
+void app_acct_tx(enum app_acct_subsystem subsystem, uint32_t msgs, size_t bytes)
+{
+	atomic_add(&counters[subsystem].tx_msgs, msgs);
+	atomic_add(&counters[subsystem].tx_bytes, bytes);
+}
+
+void app_acct_rx(enum app_acct_subsystem subsystem, uint32_t msgs, size_t bytes)
+{
+	atomic_add(&counters[subsystem].rx_msgs, msgs);
+	atomic_add(&counters[subsystem].rx_bytes, bytes);
+}
+
+/* Radio connected time, runs in the thread publishing the connection event */
+static void acct_conn_cb(const struct zbus_channel *chan)
+{
+	const struct app_bus_conn *conn = zbus_chan_const_msg(chan);
+	int64_t now = k_uptime_get();
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	if (conn->connected && (radio_connected_since < 0)) {
+		radio_connected_since = now;
+	} else if (!conn->connected && (radio_connected_since >= 0)) {
+		radio_connected_ms += now - radio_connected_since;
+		radio_connected_since = -1;
+	}
+
+	k_spin_unlock(&lock, key);
+}
+
+ZBUS_LISTENER_DEFINE(acct_conn_lis, acct_conn_cb);
+ZBUS_CHAN_ADD_OBS(app_conn_chan, acct_conn_lis, 0);
+
+static uint64_t acct_radio_connected_ms(int64_t now)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	uint64_t connected_ms = radio_connected_ms;
+
+	if (radio_connected_since >= 0) {
+		connected_ms += now - radio_connected_since;
+	}
+
+	k_spin_unlock(&lock, key);
+
+	return connected_ms;
+}
+
+/* Counts log messages the Golioth log backend lets through */
+static void acct_log_process(const struct log_backend *const backend,
+			     union log_msg_generic *msg)
+{
+	static const struct log_backend *golioth_backend;
+	uint8_t level = log_msg_get_level(&msg->log);
+	const void *source = log_msg_get_source(&msg->log);
+	size_t len = 0;
+
+	if (level == LOG_LEVEL_NONE) {
+		/* printk and raw output are not sent to Golioth */
+		return;
+	}
+
+	if (!golioth_backend) {
+		golioth_backend = log_backend_get_by_name(GOLIOTH_LOG_BACKEND_NAME);
+	}
+
+	/* Logs are only sent while the backend is enabled and the client is connected */
+	if (!golioth_backend || !log_backend_is_active(golioth_backend) ||
+	    !app_bus_is_connected()) {
+		return;
+	}
+
+	if (IS_ENABLED(CONFIG_LOG_RUNTIME_FILTERING) && source) {
+		uint32_t source_id =
+			log_dynamic_source_id((struct log_source_dynamic_data *)source);
+
+		if (level > log_filter_get(golioth_backend, log_msg_get_domain(&msg->log),
+					   source_id, true)) {
+			return;
+		}
+	}
+
+	log_msg_get_package(&msg->log, &len);
+	app_acct_tx(APP_ACCT_LOGS, 1, len);
+}
+
+static void acct_log_panic(const struct log_backend *const backend)
+{
+	/* Nothing buffered, and nothing is sent to Golioth after a panic */
+}
+
+static void acct_log_dropped(const struct log_backend *const backend, uint32_t cnt)
+{
+	/* Dropped messages reach no backend, so none of them were sent */
+}
+
+static const struct log_backend_api acct_log_api = {
+	.process = acct_log_process,
+	.panic = acct_log_panic,
+	.dropped = acct_log_dropped,
+};
+
+LOG_BACKEND_DEFINE(acct_log_backend, acct_log_api, true);
+
+/*
+ * The report is queued as bulk traffic in pieces that each fit an uplink
+ * slot. Every piece is a map holding some of the top level keys of the report:
+ * the totals, the charge estimate, one subsystem, or as many threads as fit.
+ */
+
+/* Map header and "uptime_s", "cpu_active_ms" and "radio_connected_s" with their values */
+#define ACCT_TOTALS_MAX_LEN (1 + (9 + 5) + (14 + 9) + (18 + 5))
+
+/* Map header, "uah" and a map of "cpu", "sleep", "radio" and "total" */
+#define ACCT_UAH_MAX_LEN (1 + 4 + 1 + (4 + 5) + (6 + 5) + (6 + 5) + (6 + 5))
+
+/* Map header, "subsystems", map header, the longest name and a map of its counters */
+#define ACCT_SUBSYSTEM_MAX_LEN                                                                     \
+	(1 + 11 + 1 + 9 + 1 + (3 + 5) + (9 + 5) + (3 + 5) + (9 + 5) + (4 + 5))
+
+/* Indefinite length outer map with "threads" and an indefinite length inner map */
+#define ACCT_THREADS_OVERHEAD (2 + 8 + 2)
+
+/* Name with a header of up to 2 bytes and a 32-bit value */
+#define ACCT_THREAD_MAX_LEN(name_len) (2 + (name_len) + 5)
+
+/* Keeps the header of the inner map in a single byte */
+#define ACCT_THREADS_PER_PIECE 23
+
+/* Totals, charge estimate and one piece per subsystem, plus the thread pieces */
+#define ACCT_FIXED_PIECES (2 + APP_ACCT_SUBSYSTEM_COUNT)
+
+/* Bulk slots left to regular telemetry */
+#define ACCT_BULK_RESERVE (CONFIG_APP_UPLINK_BULK_QUEUE_LEN / 2)
+
+BUILD_ASSERT(MAX(MAX(ACCT_TOTALS_MAX_LEN, ACCT_UAH_MAX_LEN), ACCT_SUBSYSTEM_MAX_LEN) <=
+		     CONFIG_APP_UPLINK_PAYLOAD_MAX_LEN,
+	     "Accounting report piece does not fit an uplink message");
+BUILD_ASSERT(ACCT_THREADS_OVERHEAD + ACCT_THREAD_MAX_LEN(CONFIG_THREAD_MAX_NAME_LEN) <=
+		     CONFIG_APP_UPLINK_PAYLOAD_MAX_LEN,
+	     "Accounting report thread does not fit an uplink message");
+BUILD_ASSERT(ACCT_FIXED_PIECES + 1 + ACCT_BULK_RESERVE <= CONFIG_APP_UPLINK_BULK_QUEUE_LEN,
+	     "Accounting report does not fit the bulk queue");
+
+static int acct_send(const uint8_t *buf, size_t len)
+{
+	if (app_uplink_free_get(APP_UPLINK_BULK) <= ACCT_BULK_RESERVE) {
+		/* Do not push sensor readings out of the queue */
+		return -ENOBUFS;
+	}
+
+	return app_uplink_send(APP_UPLINK_BULK, APP_UPLINK_SVC_STREAM, ACCT_PATH,
+			       GOLIOTH_CONTENT_TYPE_CBOR, buf, len);
+}
+
+struct thread_piece {
+	uint8_t buf[CONFIG_APP_UPLINK_PAYLOAD_MAX_LEN];
+	zcbor_state_t zse[4];
+	/* Only count the pieces if not set */
+	bool send;
+	uint32_t pieces;
+	uint32_t count;
+	int err;
+};
+
+static void thread_piece_start(struct thread_piece *p)
+{
+	zcbor_new_encode_state(p->zse, ARRAY_SIZE(p->zse), p->buf, sizeof(p->buf), 1);
+	p->count = 0;
+
+	/* Always fits, see ACCT_THREADS_OVERHEAD */
+	(void)(zcbor_map_start_encode(p->zse, 1) && zcbor_tstr_put_lit(p->zse, "threads") &&
+	       zcbor_map_start_encode(p->zse, ACCT_THREADS_PER_PIECE));
+}
+
+static int thread_piece_send(struct thread_piece *p)
+{
+	int err = 0;
+
+	if (!zcbor_map_end_encode(p->zse, ACCT_THREADS_PER_PIECE) ||
+	    !zcbor_map_end_encode(p->zse, 1)) {
+		return -ENOMEM;
+	}
+
+	if (p->send) {
+		err = acct_send(p->buf, p->zse->payload - p->buf);
+	}
+
+	if (!err) {
+		p->pieces++;
+	}
+
+	return err;
+}
+
+static void encode_thread_cpu(const struct k_thread *thread, void *user_data)
+{
+	struct thread_piece *p = user_data;
+	k_thread_runtime_stats_t stats;
+	const char *name = k_thread_name_get((k_tid_t)thread);
+
+	if (p->err || !name || (k_thread_runtime_stats_get((k_tid_t)thread, &stats) != 0)) {
+		return;
+	}
+
+	uint32_t cpu_ms = k_cyc_to_ms_floor64(stats.execution_cycles);
+
+	if (cpu_ms == 0) {
+		return;
+	}
+
+	size_t name_len = strnlen(name, CONFIG_THREAD_MAX_NAME_LEN);
+
+	/* Room for the thread and both map ends, else send what we have */
+	if ((p->count == ACCT_THREADS_PER_PIECE) ||
+	    ((size_t)(p->zse->payload_end - p->zse->payload) < ACCT_THREAD_MAX_LEN(name_len) + 2)) {
+		p->err = thread_piece_send(p);
+		if (p->err) {
+			return;
+		}
+
+		thread_piece_start(p);
+	}
+
+	if (!zcbor_tstr_encode_ptr(p->zse, name, name_len) || !zcbor_uint32_put(p->zse, cpu_ms)) {
+		p->err = -ENOMEM;
+		return;
+	}
+
+	p->count++;
+}
+
+/* Encode the thread pieces and send them, or only count them if !send */
+static int acct_threads(bool send, uint32_t *pieces)
+{
+	/* Only used by the sensor loop */
+	static struct thread_piece piece;
+
+	piece.send = send;
+	piece.pieces = 0;
+	piece.err = 0;
+	thread_piece_start(&piece);
+	k_thread_foreach_unlocked(encode_thread_cpu, &piece);
+
+	if (!piece.err && (piece.count > 0)) {
+		piece.err = thread_piece_send(&piece);
+	}
+
+	*pieces = piece.pieces;
+
+	return piece.err;
+}
+
+static int acct_send_totals(int64_t now, uint64_t active_ms, uint64_t radio_ms)
+{
+	uint8_t buf[ACCT_TOTALS_MAX_LEN];
+
+	ZCBOR_STATE_E(zse, 1, buf, sizeof(buf), 1);
+
+	bool ok = zcbor_map_start_encode(zse, 3) && zcbor_tstr_put_lit(zse, "uptime_s") &&
+		  zcbor_uint32_put(zse, now / MSEC_PER_SEC) &&
+		  zcbor_tstr_put_lit(zse, "cpu_active_ms") && zcbor_uint64_put(zse, active_ms) &&
+		  zcbor_tstr_put_lit(zse, "radio_connected_s") &&
+		  zcbor_uint32_put(zse, radio_ms / MSEC_PER_SEC) && zcbor_map_end_encode(zse, 3);
+
+	return ok ? acct_send(buf, zse->payload - buf) : -ENOMEM;
+}
+
+/* Charge attributed to the subsystem in uA*ms */
+static uint64_t acct_subsystem_uams(const struct acct_counters *c)
+{
+	uint32_t msgs = atomic_get(&c->tx_msgs) + atomic_get(&c->rx_msgs);
+	uint32_t bytes = atomic_get(&c->tx_bytes) + atomic_get(&c->rx_bytes);
+
+	return (uint64_t)msgs * CONFIG_APP_ACCT_MSG_UAS * MSEC_PER_SEC +
+	       (uint64_t)bytes * CONFIG_APP_ACCT_BYTE_UAMS;
+}
+
+static int acct_send_subsystem(int i, uint64_t uams)
+{
+	uint8_t buf[ACCT_SUBSYSTEM_MAX_LEN];
+	struct acct_counters *c = &counters[i];
+
+	ZCBOR_STATE_E(zse, 3, buf, sizeof(buf), 1);
+
+	bool ok = zcbor_map_start_encode(zse, 1) && zcbor_tstr_put_lit(zse, "subsystems") &&
+		  zcbor_map_start_encode(zse, 1) &&
+		  zcbor_tstr_put_term(zse, subsystem_names[i], SIZE_MAX) &&
+		  zcbor_map_start_encode(zse, 5) && zcbor_tstr_put_lit(zse, "tx") &&
+		  zcbor_uint32_put(zse, atomic_get(&c->tx_msgs)) &&
+		  zcbor_tstr_put_lit(zse, "tx_bytes") &&
+		  zcbor_uint32_put(zse, atomic_get(&c->tx_bytes)) &&
+		  zcbor_tstr_put_lit(zse, "rx") && zcbor_uint32_put(zse, atomic_get(&c->rx_msgs)) &&
+		  zcbor_tstr_put_lit(zse, "rx_bytes") &&
+		  zcbor_uint32_put(zse, atomic_get(&c->rx_bytes)) &&
+		  zcbor_tstr_put_lit(zse, "uah") &&
+		  zcbor_uint32_put(zse, uams / UAMS_PER_UAH) && zcbor_map_end_encode(zse, 5) &&
+		  zcbor_map_end_encode(zse, 1) && zcbor_map_end_encode(zse, 1);
+
+	return ok ? acct_send(buf, zse->payload - buf) : -ENOMEM;
+}
+
+static int acct_send_uah(uint64_t cpu_uams, uint64_t sleep_uams, uint64_t radio_uams,
+			 uint64_t subsystems_uams)
+{
+	uint8_t buf[ACCT_UAH_MAX_LEN];
+
+	ZCBOR_STATE_E(zse, 2, buf, sizeof(buf), 1);
+
+	bool ok = zcbor_map_start_encode(zse, 1) && zcbor_tstr_put_lit(zse, "uah") &&
+		  zcbor_map_start_encode(zse, 4) && zcbor_tstr_put_lit(zse, "cpu") &&
+		  zcbor_uint32_put(zse, cpu_uams / UAMS_PER_UAH) &&
+		  zcbor_tstr_put_lit(zse, "sleep") &&
+		  zcbor_uint32_put(zse, sleep_uams / UAMS_PER_UAH) &&
+		  zcbor_tstr_put_lit(zse, "radio") &&
+		  zcbor_uint32_put(zse, radio_uams / UAMS_PER_UAH) &&
+		  zcbor_tstr_put_lit(zse, "total") &&
+		  zcbor_uint32_put(zse, (cpu_uams + sleep_uams + radio_uams + subsystems_uams) /
+						UAMS_PER_UAH) &&
+		  zcbor_map_end_encode(zse, 4) && zcbor_map_end_encode(zse, 1);
+
+	return ok ? acct_send(buf, zse->payload - buf) : -ENOMEM;
+}
+
+/* The pieces most useful on their own are queued first */
+static int acct_send_report(int64_t now)
+{
+	k_thread_runtime_stats_t all;
+	uint64_t active_ms = 0;
+	uint64_t uams[APP_ACCT_SUBSYSTEM_COUNT];
+	uint64_t subsystems_uams = 0;
+	uint32_t pieces;
+	int err;
+
+	if (k_thread_runtime_stats_all_get(&all) == 0) {
+		active_ms = k_cyc_to_ms_floor64(all.total_cycles);
+	}
+
+	uint64_t radio_ms = acct_radio_connected_ms(now);
+	uint64_t sleep_ms = (now > active_ms) ? (now - active_ms) : 0;
+
+	for (int i = 0; i < APP_ACCT_SUBSYSTEM_COUNT; i++) {
+		uams[i] = acct_subsystem_uams(&counters[i]);
+		subsystems_uams += uams[i];
+	}
+
+	err = acct_send_totals(now, active_ms, radio_ms);
+	if (err) {
+		return err;
+	}
+
+	err = acct_send_uah(active_ms * CONFIG_APP_ACCT_CPU_ACTIVE_UA,
+			    sleep_ms * CONFIG_APP_ACCT_SLEEP_UA,
+			    radio_ms * CONFIG_APP_ACCT_RADIO_CONNECTED_UA, subsystems_uams);
+	if (err) {
+		return err;
+	}
+
+	for (int i = 0; i < APP_ACCT_SUBSYSTEM_COUNT; i++) {
+		err = acct_send_subsystem(i, uams[i]);
+		if (err) {
+			return err;
+		}
+	}
+
+	return acct_threads(true, &pieces);
+}
+
+void app_acct_report(struct golioth_client *client)
+{
+	static int64_t last_report;
+	int64_t now = k_uptime_get();
+	uint32_t pieces;
+	int err;
+
+	if ((now - last_report < CONFIG_APP_ACCT_REPORT_INTERVAL_S * MSEC_PER_SEC) ||
+	    !golioth_client_is_connected(client)) {
+		return;
+	}
+
+	err = acct_threads(false, &pieces);
+	if (err) {
+		LOG_ERR("Failed to encode accounting report: %d", err);
+		return;
+	}
+
+	/* Queue the whole report next to the reserve, or retry on the next loop */
+	if (app_uplink_free_get(APP_UPLINK_BULK) < ACCT_FIXED_PIECES + pieces + ACCT_BULK_RESERVE) {
+		return;
+	}
+
+	/* A partial report is not retried, the counters are cumulative */
+	last_report = now;
+
+	err = acct_send_report(now);
+	if (err) {
+		LOG_ERR("Failed to queue accounting report: %d", err);
+	}
+}
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2026 Golioth, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/** Traffic and energy accounting per subsystem.
+ *
+ * Messages and bytes are counted per subsystem and direction where the
+ * application sends or receives them:
+ *
+ * - `stream`: Stream writes from the uplink scheduler and the benchmark
+ * - `state`: LightDB State writes and received desired state
+ * - `rpc`: RPC requests (parameters) and responses (details)
+ * - `settings`: received setting values
+ * - `logs`: log messages passing the Golioth log backend filter, with bytes
+ *   estimated from the size of the log message
+ * - `ota`: downloaded firmware images, counted in blocks
+ *
+ * CPU time is taken from the thread runtime statistics, and radio connected
+ * time from the connection events `main.c` publishes on `app_conn_chan`.
+ * Charge is estimated from the per-board cost model in Kconfig
+ * (`CONFIG_APP_ACCT_*_UA` and friends), and attributed to each subsystem from
+ * its messages and bytes.
+ *
+ * `app_acct_report()` runs next to the battery report in the sensor loop and
+ * queues the counters for the `accounting` path every
+ * `CONFIG_APP_ACCT_REPORT_INTERVAL_S`, as bulk uplink messages that each
+ * carry part of the report. It waits until all of them fit next to the half
+ * of the bulk queue kept for sensor readings.
+ *
+ * With `CONFIG_APP_ACCT` disabled the calls compile to nothing.
+ */
+
+#ifndef __APP_ACCT_H__
+#define __APP_ACCT_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <golioth/client.h>
+
+enum app_acct_subsystem {
+	APP_ACCT_STREAM,
+	APP_ACCT_STATE,
+	APP_ACCT_RPC,
+	APP_ACCT_SETTINGS,
+	APP_ACCT_LOGS,
+	APP_ACCT_OTA,
+	APP_ACCT_SUBSYSTEM_COUNT
+};
+
+#ifdef CONFIG_APP_ACCT
+
+void app_acct_tx(enum app_acct_subsystem subsystem, uint32_t msgs, size_t bytes);
+void app_acct_rx(enum app_acct_subsystem subsystem, uint32_t msgs, size_t bytes);
+
+/** Stream the counters if the report interval has passed */
+void app_acct_report(struct golioth_client *client);
+
+#else
+
+static inline void app_acct_tx(enum app_acct_subsystem subsystem, uint32_t msgs, size_t bytes)
+{
+}
+
+static inline void app_acct_rx(enum app_acct_subsystem subsystem, uint32_t msgs, size_t bytes)
+{
+}
+
+static inline void app_acct_report(struct golioth_client *client)
+{
+}
+
+#endif /* CONFIG_APP_ACCT */
+
+#endif /* __APP_ACCT_H__ */
@@ -0,0 +1,214 @@
+/*
+ * Copyright (c) 2026 Golioth, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(app_backlog, LOG_LEVEL_DBG);
+
+#include <string.h>
+#include <golioth/client.h>
+#include <zcbor_encode.h>
+#include <zephyr/kernel.h>
+#include <zephyr/zbus/zbus.h>
+
+#include "app_backlog.h"
+#include "app_bus.h"
+#include "app_codec.h"
+#include "app_ota.h"
+#include "app_sensors.h"
+#include "app_uplink.h"
+
+/* One spare slot for the newest reading before it is merged in */
+#define BACKLOG_CAPACITY (CONFIG_APP_BACKLOG_PER_LEVEL * CONFIG_APP_BACKLOG_LEVELS + 1)
+
+/* Ordered oldest to newest, levels never increase from one entry to the next */
+static struct app_backlog_entry entries[BACKLOG_CAPACITY];
+static uint32_t len;
+
+static void backlog_remove(uint32_t index)
+{
+	memmove(&entries[index], &entries[index + 1], (len - index - 1) * sizeof(entries[0]));
+	len--;
+}
+
+/* Merge the entry at index with the next (newer) one */
+static void backlog_merge(uint32_t index)
+{
+	struct app_backlog_entry *older = &entries[index];
+	struct app_backlog_entry *newer = &entries[index + 1];
+	uint32_t count = older->count + newer->count;
+
+	older->mean = ((int64_t)older->mean * older->count + (int64_t)newer->mean * newer->count) /
+		      count;
+	older->min = MIN(older->min, newer->min);
+	older->max = MAX(older->max, newer->max);
+	older->last_s = newer->last_s;
+	older->count = count;
+	older->level = MIN(older->level + 1, CONFIG_APP_BACKLOG_LEVELS - 1);
+
+	backlog_remove(index + 1);
+}
+
+/* Restore the per level limit, at most one merge per level */
+static void backlog_compact(void)
+{
+	for (uint8_t level = 0; level < CONFIG_APP_BACKLOG_LEVELS; level++) {
+		uint32_t first = 0;
+		uint32_t n = 0;
+
+		for (uint32_t i = 0; i < len; i++) {
+			if (entries[i].level == level) {
+				first = (n == 0) ? i : first;
+				n++;
+			}
+		}
+
+		if (n <= CONFIG_APP_BACKLOG_PER_LEVEL) {
+			/* Higher levels are unchanged, so they are within limits too */
+			break;
+		}
+
+		/* Entries of one level are contiguous, merge its two oldest */
+		backlog_merge(first);
+	}
+}
+
+void app_backlog_add(int32_t value, int64_t timestamp)
+{
+	uint32_t time_s = timestamp / MSEC_PER_SEC;
+
+	entries[len++] = (struct app_backlog_entry){
+		.first_s = time_s,
+		.last_s = time_s,
+		.count = 1,
+		.min = value,
+		.max = value,
+		.mean = value,
+		.level = 0,
+	};
+
+	backlog_compact();
+}
+
+uint32_t app_backlog_count(void)
+{
+	return len;
+}
+
+static int backlog_encode(const struct app_backlog_entry *entry, const char *key, uint32_t now_s,
+			  uint8_t *buf, size_t buf_len, size_t *encoded_len, size_t *age_offset)
+{
+	bool merged = entry->count > 1;
+
+	ZCBOR_STATE_E(zse, 1, buf, buf_len, 1);
+
+	bool ok = zcbor_map_start_encode(zse, 6) &&
+		  zcbor_tstr_put_term(zse, key, CONFIG_APP_UPLINK_PATH_MAX_LEN) &&
+		  zcbor_int32_put(zse, entry->mean) && zcbor_tstr_put_lit(zse, "age_s");
+
+	/* Advanced by the uplink scheduler until the entry is actually sent */
+	*age_offset = zse->payload - buf;
+	ok = ok && app_codec_age_put(zse, now_s - entry->last_s);
+
+	if (ok && merged) {
+		ok = zcbor_tstr_put_lit(zse, "min") && zcbor_int32_put(zse, entry->min) &&
+		     zcbor_tstr_put_lit(zse, "max") && zcbor_int32_put(zse, entry->max) &&
+		     zcbor_tstr_put_lit(zse, "n") && zcbor_uint32_put(zse, entry->count) &&
+		     zcbor_tstr_put_lit(zse, "span_s") &&
+		     zcbor_uint32_put(zse, entry->last_s - entry->first_s);
+	}
+
+	ok = ok && zcbor_map_end_encode(zse, 6);
+
+	if (!ok) {
+		return -ENOMEM;
+	}
+
+	*encoded_len = zse->payload - buf;
+
+	return 0;
+}
+
+uint32_t app_backlog_flush(const char *path, const char *key, uint32_t max_entries, int64_t now)
+{
+	uint8_t cbor_buf[CONFIG_APP_UPLINK_PAYLOAD_MAX_LEN];
+	uint32_t now_s = now / MSEC_PER_SEC;
+	uint32_t queued = 0;
+	size_t age_offset;
+	size_t cbor_size;
+	int err;
+
+	while ((queued < max_entries) && (len > 0)) {
+		err = backlog_encode(&entries[0], key, now_s, cbor_buf, sizeof(cbor_buf),
+				     &cbor_size, &age_offset);
+		if (err) {
+			LOG_ERR("Failed to encode CBOR.");
+			backlog_remove(0);
+			continue;
+		}
+
+		err = app_uplink_send_aged(APP_UPLINK_BULK, APP_UPLINK_SVC_STREAM, path,
+					   GOLIOTH_CONTENT_TYPE_CBOR, cbor_buf, cbor_size,
+					   age_offset);
+		if (err == -ENOBUFS) {
+			/* Keep the entry for the next flush */
+			break;
+		} else if (err) {
+			LOG_ERR("Failed to queue backlog entry: %d", err);
+		} else {
+			queued++;
+		}
+
+		backlog_remove(0);
+	}
+
+	if (queued) {
+		LOG_DBG("Queued %u backlog entries, %u remaining", queued, len);
+	}
+
+	return queued;
+}
+
+static void backlog_on_sample(const struct app_bus_sample *sample)
+{
+	/* The reading is streamed, send the ones buffered before it */
+	if (sample->live) {
+		/* Leave room for live data */
+		app_backlog_flush(APP_SENSORS_STREAM_PATH, APP_SENSORS_COUNTER_KEY,
+				  app_uplink_free_get(APP_UPLINK_BULK) / 2, sample->timestamp);
+		return;
+	}
+
+	LOG_DBG("Bulk uplink unavailable, buffering counter: %d", sample->counter);
+	app_backlog_add(sample->counter, sample->timestamp);
+}
+
+ZBUS_MSG_SUBSCRIBER_DEFINE(backlog_sub);
+ZBUS_CHAN_ADD_OBS(app_sample_chan, backlog_sub, 3);
+ZBUS_CHAN_ADD_OBS(app_conn_chan, backlog_sub, 3);
+
+/* Persistence observer, the only user of the backlog */
+static void backlog_thread(void *p1, void *p2, void *p3)
+{
+	const struct zbus_channel *chan;
+	union {
+		struct app_bus_sample sample;
+		struct app_bus_conn conn;
+	} msg;
+
+	while (zbus_sub_wait_msg(&backlog_sub, &chan, &msg, K_FOREVER) == 0) {
+		if (chan == &app_sample_chan) {
+			backlog_on_sample(&msg.sample);
+		} else if ((chan == &app_conn_chan) && msg.conn.connected &&
+			   !app_ota_is_downloading() && len) {
+			/* Bulk traffic is held during a firmware download, keep buffering */
+			app_backlog_flush(APP_SENSORS_STREAM_PATH, APP_SENSORS_COUNTER_KEY,
+					  app_uplink_free_get(APP_UPLINK_BULK) / 2, k_uptime_get());
+		}
+	}
+}
+
+K_THREAD_DEFINE(backlog_tid, CONFIG_APP_BUS_OBSERVER_STACK_SIZE, backlog_thread, NULL, NULL, NULL,
+		CONFIG_APP_BUS_OBSERVER_THREAD_PRIORITY, 0, 0);
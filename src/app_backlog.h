@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2026 Golioth, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/** Bounded offline backlog of sensor readings with progressive downsampling.
+ *
+ * While no connection is available, readings are buffered here instead of
+ * being dropped. When the buffer fills up, the oldest data is not evicted
+ * but merged: the backlog is an exponential histogram where every entry holds
+ * the min, max and mean of 2^level adjacent readings. At most
+ * `CONFIG_APP_BACKLOG_PER_LEVEL` entries exist per level, so whenever a level
+ * overflows its two oldest entries are merged into one entry of the next
+ * level. Recent readings keep full resolution while older ones are reduced
+ * further the older they get, so a long outage still yields a curve over its
+ * whole duration.
+ *
+ * Memory is fixed at `CONFIG_APP_BACKLOG_PER_LEVEL * CONFIG_APP_BACKLOG_LEVELS`
+ * entries and every insertion does at most one merge per level, so each step
+ * runs in bounded time. Entries of the top level keep merging with each other
+ * once it is full.
+ *
+ * Readings reach the backlog as a persistence observer of the event bus (see
+ * app_bus.h): samples published while disconnected or while a firmware
+ * download holds bulk traffic (see app_ota.h) are not `live` and are added
+ * with the time they were taken, and the oldest entries are flushed on
+ * reconnect and with every following live sample. The
+ * backlog is not thread safe; it is only used from that observer's thread.
+ */
+
+#ifndef __APP_BACKLOG_H__
+#define __APP_BACKLOG_H__
+
+#include <stdint.h>
+
+struct app_backlog_entry {
+	uint32_t first_s;
+	uint32_t last_s;
+	uint32_t count;
+	int32_t min;
+	int32_t max;
+	int32_t mean;
+	uint8_t level;
+};
+
+/** Add a reading taken at `timestamp`, uptime in milliseconds */
+void app_backlog_add(int32_t value, int64_t timestamp);
+uint32_t app_backlog_count(void);
+
+/**
+ * Queue up to `max_entries` of the oldest backlog entries as bulk uplink
+ * traffic to the given Stream path, removing them from the backlog.
+ *
+ * Single readings are sent as `{key: value, "age_s": s}`. Merged entries
+ * carry the mean as `key` along with `min`, `max`, the number of readings
+ * `n` and the time `span_s` they cover. `age_s` is the time since the last
+ * reading of the entry as of sending: it is counted up to `now`, uptime in
+ * milliseconds, and the uplink scheduler adds the time the message waited in
+ * its queue (see `app_uplink_send_aged()`).
+ *
+ * @return number of entries queued
+ */
+uint32_t app_backlog_flush(const char *path, const char *key, uint32_t max_entries, int64_t now);
+
+#endif /* __APP_BACKLOG_H__ */
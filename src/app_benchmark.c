@@ -0,0 +1,494 @@
+/*
+ * Copyright (c) 2026 Golioth, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(app_benchmark, LOG_LEVEL_DBG);
+
+#include <errno.h>
+#include <string.h>
+#include <golioth/client.h>
+#include <golioth/stream.h>
+#include <zcbor_decode.h>
+#include <zcbor_encode.h>
+#include <zephyr/data/json.h>
+#include <zephyr/kernel.h>
+#include <zephyr/spinlock.h>
+#include <zephyr/storage/flash_map.h>
+
+#ifdef CONFIG_LIB_OSTENTUS
+#include <libostentus.h>
+static const struct device *o_dev = DEVICE_DT_GET_ANY(golioth_ostentus);
+#endif
+
+#include "app_acct.h"
+#include "app_benchmark.h"
+#include "json_helper.h"
+
+#define BENCHMARK_PATH "benchmark"
+#define ECHO_PATH "benchmark/echo"
+#define ECHO_TIMEOUT K_SECONDS(10)
+#define I2C_ROUNDS 10
+#define FLASH_CHUNK 256
+#define DESIRED_STATE_JSON "{\"example_int0\":1234,\"example_int1\":-1}"
+
+/*
+ * The flash benchmark erases its partition, so it only runs on one reserved
+ * for it: benchmark_storage in pm_static.yml, or benchmark_partition in the
+ * devicetree of boards without the Partition Manager.
+ */
+#if defined(CONFIG_PARTITION_MANAGER_ENABLED)
+#include <pm_config.h>
+#if defined(PM_BENCHMARK_STORAGE_ID)
+#define BENCH_FLASH_AREA_ID PM_BENCHMARK_STORAGE_ID
+#endif
+#elif FIXED_PARTITION_EXISTS(benchmark_partition)
+#define BENCH_FLASH_AREA_ID FIXED_PARTITION_ID(benchmark_partition)
+#endif
+
+struct benchmark_results {
+	enum app_benchmark_state state;
+	uint32_t id;
+	uint32_t total_ms;
+	uint32_t cbor_encode_us;
+	uint32_t cbor_encode_bytes_per_s;
+	int cbor_parse_err;
+	uint32_t cbor_parse_us;
+	int json_parse_err;
+	uint32_t json_parse_us;
+	int flash_err;
+	uint32_t flash_erase_us;
+	uint32_t flash_write_us;
+	uint32_t flash_read_us;
+	int i2c_err;
+	uint32_t i2c_rtt_us;
+	int echo_err;
+	uint32_t echo_min_ms;
+	uint32_t echo_avg_ms;
+	uint32_t echo_max_ms;
+};
+
+static struct benchmark_results results;
+static struct golioth_client *client;
+
+/* Not on the stack, a timed out request may still complete later */
+static enum golioth_status echo_status;
+static struct k_spinlock lock;
+
+K_SEM_DEFINE(benchmark_sem, 0, 1);
+K_SEM_DEFINE(echo_sem, 0, 1);
+
+static uint32_t elapsed_us(uint32_t start)
+{
+	return k_cyc_to_us_floor32(k_cycle_get_32() - start);
+}
+
+static size_t bench_encode_one(uint8_t *buf, size_t buf_len, uint32_t seq)
+{
+	ZCBOR_STATE_E(zse, 2, buf, buf_len, 1);
+
+	bool ok = zcbor_map_start_encode(zse, 5) && zcbor_tstr_put_lit(zse, "id") &&
+		  zcbor_uint32_put(zse, 1) && zcbor_tstr_put_lit(zse, "seq") &&
+		  zcbor_uint32_put(zse, seq) && zcbor_tstr_put_lit(zse, "of") &&
+		  zcbor_uint32_put(zse, CONFIG_APP_BENCHMARK_ITERATIONS) &&
+		  zcbor_tstr_put_lit(zse, "hz") && zcbor_uint32_put(zse, 100) &&
+		  zcbor_tstr_put_lit(zse, "s") && zcbor_list_start_encode(zse, 8);
+
+	for (uint32_t i = 0; ok && (i < 8); i++) {
+		ok = zcbor_uint32_put(zse, seq + i * 300);
+	}
+
+	ok = ok && zcbor_list_end_encode(zse, 8) && zcbor_map_end_encode(zse, 5);
+
+	return ok ? (zse->payload - buf) : 0;
+}
+
+static void bench_cbor_encode(struct benchmark_results *r)
+{
+	uint8_t buf[64];
+	uint64_t bytes = 0;
+	uint32_t start = k_cycle_get_32();
+
+	for (uint32_t i = 0; i < CONFIG_APP_BENCHMARK_ITERATIONS; i++) {
+		bytes += bench_encode_one(buf, sizeof(buf), i);
+	}
+
+	uint32_t us = MAX(elapsed_us(start), 1);
+
+	r->cbor_encode_us = us / CONFIG_APP_BENCHMARK_ITERATIONS;
+	r->cbor_encode_bytes_per_s = (uint32_t)(bytes * USEC_PER_SEC / us);
+}
+
+static void bench_cbor_parse(struct benchmark_results *r)
+{
+	uint8_t buf[40];
+	int32_t value0;
+	int32_t value1;
+
+	ZCBOR_STATE_E(zse, 1, buf, sizeof(buf), 1);
+
+	bool ok = zcbor_map_start_encode(zse, 2) && zcbor_tstr_put_lit(zse, "example_int0") &&
+		  zcbor_int32_put(zse, 1234) && zcbor_tstr_put_lit(zse, "example_int1") &&
+		  zcbor_int32_put(zse, -1) && zcbor_map_end_encode(zse, 2);
+
+	if (!ok) {
+		r->cbor_parse_err = -ENOMEM;
+		return;
+	}
+
+	size_t len = zse->payload - buf;
+	uint32_t start = k_cycle_get_32();
+
+	for (uint32_t i = 0; ok && (i < CONFIG_APP_BENCHMARK_ITERATIONS); i++) {
+		ZCBOR_STATE_D(zsd, 1, buf, len, 1, 0);
+
+		ok = zcbor_map_start_decode(zsd) && zcbor_tstr_expect_lit(zsd, "example_int0") &&
+		     zcbor_int32_decode(zsd, &value0) &&
+		     zcbor_tstr_expect_lit(zsd, "example_int1") &&
+		     zcbor_int32_decode(zsd, &value1) && zcbor_map_end_decode(zsd);
+	}
+
+	r->cbor_parse_err = ok ? 0 : -EBADMSG;
+	r->cbor_parse_us = elapsed_us(start) / CONFIG_APP_BENCHMARK_ITERATIONS;
+}
+
+static void bench_json_parse(struct benchmark_results *r)
+{
+	char buf[sizeof(DESIRED_STATE_JSON)];
+	struct app_state parsed;
+	int ret = 0;
+	uint32_t start = k_cycle_get_32();
+
+	for (uint32_t i = 0; (ret >= 0) && (i < CONFIG_APP_BENCHMARK_ITERATIONS); i++) {
+		/* The parser may modify its input, start from a fresh copy */
+		memcpy(buf, DESIRED_STATE_JSON, sizeof(buf));
+		ret = json_obj_parse(buf, sizeof(buf) - 1, app_state_descr,
+				     ARRAY_SIZE(app_state_descr), &parsed);
+	}
+
+	r->json_parse_err = (ret < 0) ? ret : 0;
+	r->json_parse_us = elapsed_us(start) / CONFIG_APP_BENCHMARK_ITERATIONS;
+}
+
+static void bench_flash(struct benchmark_results *r)
+{
+#ifdef BENCH_FLASH_AREA_ID
+	static uint8_t buf[FLASH_CHUNK];
+	const struct flash_area *fa;
+	uint32_t start;
+	int err;
+
+	err = flash_area_open(BENCH_FLASH_AREA_ID, &fa);
+	if (err) {
+		r->flash_err = err;
+		return;
+	}
+
+	if (fa->fa_size < CONFIG_APP_BENCHMARK_FLASH_BYTES) {
+		r->flash_err = -ENOSPC;
+		goto close;
+	}
+
+	start = k_cycle_get_32();
+	err = flash_area_erase(fa, 0, CONFIG_APP_BENCHMARK_FLASH_BYTES);
+	r->flash_erase_us = elapsed_us(start);
+	if (err) {
+		goto close;
+	}
+
+	for (uint32_t i = 0; i < sizeof(buf); i++) {
+		buf[i] = i;
+	}
+
+	start = k_cycle_get_32();
+	for (uint32_t off = 0; !err && (off < CONFIG_APP_BENCHMARK_FLASH_BYTES);
+	     off += sizeof(buf)) {
+		err = flash_area_write(fa, off, buf, sizeof(buf));
+	}
+	r->flash_write_us = elapsed_us(start);
+	if (err) {
+		goto close;
+	}
+
+	start = k_cycle_get_32();
+	for (uint32_t off = 0; !err && (off < CONFIG_APP_BENCHMARK_FLASH_BYTES);
+	     off += sizeof(buf)) {
+		err = flash_area_read(fa, off, buf, sizeof(buf));
+	}
+	r->flash_read_us = elapsed_us(start);
+
+close:
+	r->flash_err = r->flash_err ? r->flash_err : err;
+	flash_area_close(fa);
+#else
+	r->flash_err = -ENOTSUP;
+#endif
+}
+
+static void bench_i2c(struct benchmark_results *r)
+{
+#ifdef CONFIG_LIB_OSTENTUS
+	char version[32];
+
+	if (!device_is_ready(o_dev)) {
+		r->i2c_err = -ENODEV;
+		return;
+	}
+
+	uint32_t start = k_cycle_get_32();
+
+	for (int i = 0; i < I2C_ROUNDS; i++) {
+		int err = ostentus_version_get(o_dev, version, sizeof(version));
+
+		if (err < 0) {
+			r->i2c_err = err;
+			return;
+		}
+	}
+
+	r->i2c_rtt_us = elapsed_us(start) / I2C_ROUNDS;
+#else
+	r->i2c_err = -ENODEV;
+#endif
+}
+
+static void echo_handler(struct golioth_client *client, enum golioth_status status,
+			 const struct golioth_coap_rsp_code *coap_rsp_code, const char *path,
+			 void *arg)
+{
+	echo_status = status;
+	k_sem_give(&echo_sem);
+}
+
+static void bench_echo(struct benchmark_results *r)
+{
+	uint64_t sum_ms = 0;
+	uint8_t buf[16];
+	int err;
+
+	if (!client || !golioth_client_is_connected(client)) {
+		r->echo_err = -ENOTCONN;
+		return;
+	}
+
+	r->echo_min_ms = UINT32_MAX;
+
+	for (uint32_t seq = 0; seq < CONFIG_APP_BENCHMARK_ECHO_ROUNDS; seq++) {
+		ZCBOR_STATE_E(zse, 1, buf, sizeof(buf), 1);
+
+		bool ok = zcbor_map_start_encode(zse, 1) && zcbor_tstr_put_lit(zse, "seq") &&
+			  zcbor_uint32_put(zse, seq) && zcbor_map_end_encode(zse, 1);
+
+		if (!ok) {
+			r->echo_err = -ENOMEM;
+			return;
+		}
+
+		k_sem_reset(&echo_sem);
+		int64_t start = k_uptime_get();
+
+		err = golioth_stream_set_async(client, ECHO_PATH, GOLIOTH_CONTENT_TYPE_CBOR, buf,
+					       zse->payload - buf, echo_handler, NULL);
+		if (err) {
+			r->echo_err = -EIO;
+			return;
+		}
+
+		app_acct_tx(APP_ACCT_STREAM, 1, zse->payload - buf);
+
+		if (k_sem_take(&echo_sem, ECHO_TIMEOUT) != 0) {
+			/* The handler may still run later, stop using the client */
+			r->echo_err = -ETIMEDOUT;
+			return;
+		}
+
+		if (echo_status != GOLIOTH_OK) {
+			r->echo_err = -EIO;
+			return;
+		}
+
+		uint32_t rtt_ms = (uint32_t)(k_uptime_get() - start);
+
+		r->echo_min_ms = MIN(r->echo_min_ms, rtt_ms);
+		r->echo_max_ms = MAX(r->echo_max_ms, rtt_ms);
+		sum_ms += rtt_ms;
+	}
+
+	r->echo_avg_ms = sum_ms / CONFIG_APP_BENCHMARK_ECHO_ROUNDS;
+}
+
+static bool encode_section_error(zcbor_state_t *zse, int err)
+{
+	return zcbor_tstr_put_lit(zse, "error") && zcbor_int32_put(zse, err);
+}
+
+static bool encode_results(zcbor_state_t *zse, const struct benchmark_results *r)
+{
+	const char *state = (r->state == APP_BENCHMARK_RUNNING) ? "running"
+			    : (r->state == APP_BENCHMARK_DONE)  ? "done"
+								: "idle";
+
+	bool ok = zcbor_tstr_put_lit(zse, "id") && zcbor_uint32_put(zse, r->id) &&
+		  zcbor_tstr_put_lit(zse, "state") &&
+		  zcbor_tstr_put_term(zse, state, SIZE_MAX) && zcbor_tstr_put_lit(zse, "board") &&
+		  zcbor_tstr_put_term(zse, CONFIG_BOARD, SIZE_MAX) &&
+		  zcbor_tstr_put_lit(zse, "cycles_per_s") &&
+		  zcbor_uint32_put(zse, sys_clock_hw_cycles_per_sec());
+
+	if (r->state != APP_BENCHMARK_DONE) {
+		return ok;
+	}
+
+	ok = ok && zcbor_tstr_put_lit(zse, "total_ms") && zcbor_uint32_put(zse, r->total_ms);
+
+	ok = ok && zcbor_tstr_put_lit(zse, "cbor_encode") && zcbor_map_start_encode(zse, 2) &&
+	     zcbor_tstr_put_lit(zse, "us") && zcbor_uint32_put(zse, r->cbor_encode_us) &&
+	     zcbor_tstr_put_lit(zse, "bytes_per_s") &&
+	     zcbor_uint32_put(zse, r->cbor_encode_bytes_per_s) && zcbor_map_end_encode(zse, 2);
+
+	ok = ok && zcbor_tstr_put_lit(zse, "cbor_parse") && zcbor_map_start_encode(zse, 1) &&
+	     (r->cbor_parse_err ? encode_section_error(zse, r->cbor_parse_err)
+				: (zcbor_tstr_put_lit(zse, "us") &&
+				   zcbor_uint32_put(zse, r->cbor_parse_us))) &&
+	     zcbor_map_end_encode(zse, 1);
+
+	ok = ok && zcbor_tstr_put_lit(zse, "json_parse") && zcbor_map_start_encode(zse, 1) &&
+	     (r->json_parse_err ? encode_section_error(zse, r->json_parse_err)
+				: (zcbor_tstr_put_lit(zse, "us") &&
+				   zcbor_uint32_put(zse, r->json_parse_us))) &&
+	     zcbor_map_end_encode(zse, 1);
+
+	ok = ok && zcbor_tstr_put_lit(zse, "flash") && zcbor_map_start_encode(zse, 4) &&
+	     (r->flash_err ? encode_section_error(zse, r->flash_err)
+			   : (zcbor_tstr_put_lit(zse, "bytes") &&
+			      zcbor_uint32_put(zse, CONFIG_APP_BENCHMARK_FLASH_BYTES) &&
+			      zcbor_tstr_put_lit(zse, "erase_us") &&
+			      zcbor_uint32_put(zse, r->flash_erase_us) &&
+			      zcbor_tstr_put_lit(zse, "write_us") &&
+			      zcbor_uint32_put(zse, r->flash_write_us) &&
+			      zcbor_tstr_put_lit(zse, "read_us") &&
+			      zcbor_uint32_put(zse, r->flash_read_us))) &&
+	     zcbor_map_end_encode(zse, 4);
+
+	ok = ok && zcbor_tstr_put_lit(zse, "i2c") && zcbor_map_start_encode(zse, 1) &&
+	     (r->i2c_err ? encode_section_error(zse, r->i2c_err)
+			 : (zcbor_tstr_put_lit(zse, "rtt_us") &&
+			    zcbor_uint32_put(zse, r->i2c_rtt_us))) &&
+	     zcbor_map_end_encode(zse, 1);
+
+	ok = ok && zcbor_tstr_put_lit(zse, "echo") && zcbor_map_start_encode(zse, 3) &&
+	     (r->echo_err ? encode_section_error(zse, r->echo_err)
+			  : (zcbor_tstr_put_lit(zse, "min_ms") &&
+			     zcbor_uint32_put(zse, r->echo_min_ms) &&
+			     zcbor_tstr_put_lit(zse, "avg_ms") &&
+			     zcbor_uint32_put(zse, r->echo_avg_ms) &&
+			     zcbor_tstr_put_lit(zse, "max_ms") &&
+			     zcbor_uint32_put(zse, r->echo_max_ms))) &&
+	     zcbor_map_end_encode(zse, 3);
+
+	return ok;
+}
+
+static void benchmark_stream(const struct benchmark_results *r)
+{
+	static uint8_t buf[256];
+	int err;
+
+	ZCBOR_STATE_E(zse, 2, buf, sizeof(buf), 1);
+
+	bool ok = zcbor_map_start_encode(zse, 16) && encode_results(zse, r) &&
+		  zcbor_map_end_encode(zse, 16);
+
+	if (!ok) {
+		LOG_ERR("Failed to encode benchmark results");
+		return;
+	}
+
+	/* Too large for an uplink queue slot, sent once and directly */
+	err = golioth_stream_set_async(client, BENCHMARK_PATH, GOLIOTH_CONTENT_TYPE_CBOR, buf,
+				       zse->payload - buf, NULL, NULL);
+	if (err) {
+		LOG_ERR("Failed to stream benchmark results: %d", err);
+		return;
+	}
+
+	app_acct_tx(APP_ACCT_STREAM, 1, zse->payload - buf);
+}
+
+static void benchmark_thread(void *p1, void *p2, void *p3)
+{
+	struct benchmark_results r;
+
+	while (true) {
+		k_sem_take(&benchmark_sem, K_FOREVER);
+
+		memset(&r, 0, sizeof(r));
+		r.id = results.id;
+
+		LOG_INF("Benchmark %u: running", r.id);
+
+		int64_t start = k_uptime_get();
+
+		bench_cbor_encode(&r);
+		bench_cbor_parse(&r);
+		bench_json_parse(&r);
+		bench_flash(&r);
+		bench_i2c(&r);
+		bench_echo(&r);
+
+		r.total_ms = (uint32_t)(k_uptime_get() - start);
+		r.state = APP_BENCHMARK_DONE;
+
+		k_spinlock_key_t key = k_spin_lock(&lock);
+
+		results = r;
+
+		k_spin_unlock(&lock, key);
+
+		LOG_INF("Benchmark %u: complete in %u ms", r.id, r.total_ms);
+
+		if (client && golioth_client_is_connected(client)) {
+			benchmark_stream(&r);
+		}
+	}
+}
+
+K_THREAD_DEFINE(benchmark_tid, CONFIG_APP_BENCHMARK_STACK_SIZE, benchmark_thread, NULL, NULL,
+		NULL, CONFIG_APP_BENCHMARK_THREAD_PRIORITY, 0, 0);
+
+int app_benchmark_start(struct golioth_client *benchmark_client, uint32_t *id)
+{
+	int err = 0;
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	if (results.state == APP_BENCHMARK_RUNNING) {
+		err = -EBUSY;
+	} else {
+		client = benchmark_client;
+		results.state = APP_BENCHMARK_RUNNING;
+		results.id++;
+		*id = results.id;
+	}
+
+	k_spin_unlock(&lock, key);
+
+	if (!err) {
+		k_sem_give(&benchmark_sem);
+	}
+
+	return err;
+}
+
+bool app_benchmark_results_encode(zcbor_state_t *zse)
+{
+	struct benchmark_results r;
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	r = results;
+
+	k_spin_unlock(&lock, key);
+
+	return encode_results(zse, &r);
+}
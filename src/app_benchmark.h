@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2026 Golioth, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/** On-device self-benchmark, triggered by the `run_benchmark` RPC.
+ *
+ * A fixed suite runs on a low priority background thread so results from
+ * different boards in the field can be compared directly:
+ *
+ * - `cbor_encode`: average time to encode a capture-sized CBOR map, and the
+ *   resulting throughput
+ * - `cbor_parse` / `json_parse`: average time to parse a desired state
+ *   document in either encoding
+ * - `flash`: erase, write and read of `CONFIG_APP_BENCHMARK_FLASH_BYTES` on
+ *   the `benchmark_storage` partition reserved for it, when the board has one
+ * - `i2c`: average round trip of a version read from the Ostentus, when
+ *   present
+ * - `echo`: minimum, average and maximum time from a Stream write until it is
+ *   acknowledged by Golioth
+ *
+ * A section that could not run holds an `error` code instead of results. When
+ * the suite completes, the results are streamed to the `benchmark` path and
+ * can also be read with the `get_benchmark_results` RPC.
+ */
+
+#ifndef __APP_BENCHMARK_H__
+#define __APP_BENCHMARK_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <golioth/client.h>
+#include <zcbor_common.h>
+
+enum app_benchmark_state {
+	APP_BENCHMARK_IDLE,
+	APP_BENCHMARK_RUNNING,
+	APP_BENCHMARK_DONE,
+};
+
+/**
+ * Start the benchmark suite in the background.
+ *
+ * @retval 0 suite started, `id` holds its identifier
+ * @retval -EBUSY the suite is already running
+ */
+int app_benchmark_start(struct golioth_client *client, uint32_t *id);
+
+/** Encode the state and results of the last run as pairs into an open map */
+bool app_benchmark_results_encode(zcbor_state_t *zse);
+
+#endif /* __APP_BENCHMARK_H__ */
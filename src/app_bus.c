@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2026 Golioth, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(app_bus, LOG_LEVEL_DBG);
+
+#include <zephyr/kernel.h>
+#include <zephyr/spinlock.h>
+#include <zephyr/zbus/zbus.h>
+
+#include "app_bus.h"
+
+struct chan_stats {
+	uint32_t published;
+	int64_t first;
+	int64_t last;
+};
+
+/* Messages to message subscribers are copied into fixed size pool buffers */
+BUILD_ASSERT(sizeof(struct app_bus_sample) <= CONFIG_ZBUS_MSG_SUBSCRIBER_NET_BUF_STATIC_DATA_SIZE);
+BUILD_ASSERT(sizeof(struct app_bus_conn) <= CONFIG_ZBUS_MSG_SUBSCRIBER_NET_BUF_STATIC_DATA_SIZE);
+BUILD_ASSERT(sizeof(struct app_bus_button) <= CONFIG_ZBUS_MSG_SUBSCRIBER_NET_BUF_STATIC_DATA_SIZE);
+
+/* Attached to the channels as user data */
+static struct chan_stats chan_stats[APP_BUS_CHANNEL_COUNT];
+static struct k_spinlock lock;
+
+ZBUS_CHAN_DEFINE(app_sample_chan, struct app_bus_sample, NULL, &chan_stats[APP_BUS_SAMPLE],
+		 ZBUS_OBSERVERS_EMPTY, ZBUS_MSG_INIT(0));
+
+ZBUS_CHAN_DEFINE(app_state_chan, struct app_bus_state, NULL, &chan_stats[APP_BUS_STATE],
+		 ZBUS_OBSERVERS_EMPTY, ZBUS_MSG_INIT(0));
+
+ZBUS_CHAN_DEFINE(app_settings_chan, struct app_bus_settings, NULL,
+		 &chan_stats[APP_BUS_SETTINGS], ZBUS_OBSERVERS_EMPTY, ZBUS_MSG_INIT(0));
+
+ZBUS_CHAN_DEFINE(app_conn_chan, struct app_bus_conn, NULL, &chan_stats[APP_BUS_CONN],
+		 ZBUS_OBSERVERS_EMPTY, ZBUS_MSG_INIT(.connected = false));
+
+ZBUS_CHAN_DEFINE(app_button_chan, struct app_bus_button, NULL, &chan_stats[APP_BUS_BUTTON],
+		 ZBUS_OBSERVERS_EMPTY, ZBUS_MSG_INIT(0));
+
+/* Diagnostics, runs in the publishing thread */
+static void bus_diag_cb(const struct zbus_channel *chan)
+{
+	struct chan_stats *cs = zbus_chan_user_data(chan);
+	int64_t now = k_uptime_get();
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	if (cs->published == 0) {
+		cs->first = now;
+	}
+	cs->published++;
+	cs->last = now;
+
+	k_spin_unlock(&lock, key);
+}
+
+ZBUS_LISTENER_DEFINE(bus_diag_lis, bus_diag_cb);
+
+ZBUS_CHAN_ADD_OBS(app_sample_chan, bus_diag_lis, 0);
+ZBUS_CHAN_ADD_OBS(app_state_chan, bus_diag_lis, 0);
+ZBUS_CHAN_ADD_OBS(app_settings_chan, bus_diag_lis, 0);
+ZBUS_CHAN_ADD_OBS(app_conn_chan, bus_diag_lis, 0);
+ZBUS_CHAN_ADD_OBS(app_button_chan, bus_diag_lis, 0);
+
+bool app_bus_is_connected(void)
+{
+	struct app_bus_conn conn = {0};
+
+	zbus_chan_read(&app_conn_chan, &conn, APP_BUS_PUB_TIMEOUT);
+
+	return conn.connected;
+}
+
+void app_bus_stats_get(enum app_bus_channel channel, struct app_bus_stats *stats)
+{
+	const struct chan_stats *cs = &chan_stats[channel];
+	int64_t now = k_uptime_get();
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	stats->published = cs->published;
+	stats->avg_period_ms =
+		(cs->published > 1) ? (uint32_t)((cs->last - cs->first) / (cs->published - 1)) : 0;
+	stats->last_age_ms = cs->published ? (uint32_t)(now - cs->last) : 0;
+
+	k_spin_unlock(&lock, key);
+}
+
+const char *app_bus_channel_name(enum app_bus_channel channel)
+{
+	switch (channel) {
+	case APP_BUS_SAMPLE:
+		return "sample";
+	case APP_BUS_STATE:
+		return "state";
+	case APP_BUS_SETTINGS:
+		return "settings";
+	case APP_BUS_CONN:
+		return "conn";
+	case APP_BUS_BUTTON:
+		return "button";
+	default:
+		return "unknown";
+	}
+}
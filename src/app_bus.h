@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2026 Golioth, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/** Internal event bus connecting the application modules.
+ *
+ * Producers publish each event once on a zbus channel and never call into
+ * the modules that consume it:
+ * - `app_sample_chan`: a new sensor reading (`app_sensors.c`)
+ * - `app_state_chan`: the device state changed (`app_state.c`)
+ * - `app_settings_chan`: a setting changed (`app_settings.c`)
+ * - `app_conn_chan`: the Golioth client connected or disconnected (`main.c`)
+ * - `app_button_chan`: the user button was pressed (`app_sensors.c`)
+ *
+ * Work that takes time (encoding and queueing uplinks, updating the display,
+ * buffering offline readings) runs in subscribers with their own threads, so
+ * adding a consumer does not delay the producer. Only cheap bookkeeping runs
+ * in listeners, which are called from the publishing thread. Subscribers
+ * that need the message are message subscribers: each notification carries
+ * its own copy, so a reading published while an observer is still busy with
+ * the previous one is neither lost nor read twice.
+ *
+ * How a reading is routed is decided once, when it is published: `live`
+ * readings are streamed, the others are buffered in the offline backlog (see
+ * app_backlog.h). Observers follow that decision instead of checking the
+ * connection themselves, so a reading is never both streamed and buffered.
+ *
+ * A diagnostics listener on every channel counts publications; see
+ * `app_bus_stats_get()` and the `get_bus_stats` RPC.
+ */
+
+#ifndef __APP_BUS_H__
+#define __APP_BUS_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <zephyr/kernel.h>
+#include <zephyr/zbus/zbus.h>
+
+#define APP_BUS_PUB_TIMEOUT K_MSEC(CONFIG_APP_BUS_PUB_TIMEOUT_MS)
+
+struct app_bus_sample {
+	/* Uptime in milliseconds when the reading was taken */
+	int64_t timestamp;
+	uint16_t counter;
+	/* Streamed if set, buffered in the backlog otherwise */
+	bool live;
+};
+
+struct app_bus_state {
+	uint32_t example_int0;
+	uint32_t example_int1;
+};
+
+struct app_bus_settings {
+	int32_t loop_delay_s;
+};
+
+struct app_bus_conn {
+	bool connected;
+};
+
+struct app_bus_button {
+	uint32_t presses;
+};
+
+ZBUS_CHAN_DECLARE(app_sample_chan, app_state_chan, app_settings_chan, app_conn_chan,
+		  app_button_chan);
+
+enum app_bus_channel {
+	APP_BUS_SAMPLE,
+	APP_BUS_STATE,
+	APP_BUS_SETTINGS,
+	APP_BUS_CONN,
+	APP_BUS_BUTTON,
+	APP_BUS_CHANNEL_COUNT,
+};
+
+struct app_bus_stats {
+	uint32_t published;
+	uint32_t avg_period_ms;
+	uint32_t last_age_ms;
+};
+
+/** Whether the Golioth client is connected, as last published on `app_conn_chan` */
+bool app_bus_is_connected(void);
+
+void app_bus_stats_get(enum app_bus_channel channel, struct app_bus_stats *stats);
+const char *app_bus_channel_name(enum app_bus_channel channel);
+
+#endif /* __APP_BUS_H__ */
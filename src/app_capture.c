@@ -0,0 +1,254 @@
+/*
+ * Copyright (c) 2026 Golioth, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(app_capture, LOG_LEVEL_DBG);
+
+#include <errno.h>
+#include <stdlib.h>
+#include <golioth/client.h>
+#include <zcbor_encode.h>
+#include <zephyr/kernel.h>
+#include <zephyr/spinlock.h>
+
+#include "app_capture.h"
+#include "app_sensors.h"
+#include "app_uplink.h"
+
+#define CAPTURE_PATH "capture"
+
+/* Largest rate error accepted from rounding the sample period to ticks */
+#define CAPTURE_RATE_TOLERANCE_PCT 1
+
+/* Map start and end, "id", "seq", "of" and "hz" with 32-bit values, "s", list
+ * start and end, then up to 3 bytes per 16-bit sample. Maps and lists are
+ * indefinite length, or a single header byte in canonical mode.
+ */
+#define CAPTURE_CHUNK_MAX_LEN(count)                                                               \
+	(2 + (3 + 5) + (4 + 5) + (3 + 5) + (3 + 5) + 2 + 2 + 3 * (count))
+
+BUILD_ASSERT(CAPTURE_CHUNK_MAX_LEN(CONFIG_APP_CAPTURE_CHUNK_SAMPLES) <=
+		     CONFIG_APP_UPLINK_PAYLOAD_MAX_LEN,
+	     "Capture chunk does not fit an uplink message");
+
+static uint16_t samples[CONFIG_APP_CAPTURE_MAX_SAMPLES];
+static struct app_capture_status status;
+static struct k_spinlock lock;
+
+K_SEM_DEFINE(capture_sem, 0, 1);
+K_TIMER_DEFINE(capture_timer, NULL, NULL);
+
+static uint32_t capture_period_ticks(uint32_t rate_hz)
+{
+	return DIV_ROUND_CLOSEST(CONFIG_SYS_CLOCK_TICKS_PER_SEC, rate_hz);
+}
+
+static void status_update(uint32_t *field, uint32_t value)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	*field = value;
+
+	k_spin_unlock(&lock, key);
+}
+
+static void capture_sample(uint32_t total, uint32_t rate_hz)
+{
+	/* Keep the link quiet while sampling, holding state also holds bulk traffic */
+	app_uplink_hold(APP_UPLINK_STATE, true);
+	app_uplink_log_limit(CONFIG_APP_CAPTURE_LOG_LEVEL, true);
+
+	k_timer_start(&capture_timer, K_NO_WAIT, K_TICKS(capture_period_ticks(rate_hz)));
+
+	for (uint32_t i = 0; i < total; i++) {
+		k_timer_status_sync(&capture_timer);
+		samples[i] = app_sensors_sample();
+		status_update(&status.samples, i + 1);
+	}
+
+	k_timer_stop(&capture_timer);
+
+	app_uplink_log_limit(CONFIG_APP_CAPTURE_LOG_LEVEL, false);
+	app_uplink_hold(APP_UPLINK_STATE, false);
+}
+
+static int capture_upload_chunk(uint32_t id, uint32_t seq, uint32_t chunks, uint32_t rate_hz,
+				uint32_t first, uint32_t count)
+{
+	uint8_t cbor_buf[CONFIG_APP_UPLINK_PAYLOAD_MAX_LEN];
+
+	ZCBOR_STATE_E(zse, 2, cbor_buf, sizeof(cbor_buf), 1);
+
+	bool ok = zcbor_map_start_encode(zse, 5) && zcbor_tstr_put_lit(zse, "id") &&
+		  zcbor_uint32_put(zse, id) && zcbor_tstr_put_lit(zse, "seq") &&
+		  zcbor_uint32_put(zse, seq) && zcbor_tstr_put_lit(zse, "of") &&
+		  zcbor_uint32_put(zse, chunks) && zcbor_tstr_put_lit(zse, "hz") &&
+		  zcbor_uint32_put(zse, rate_hz) && zcbor_tstr_put_lit(zse, "s") &&
+		  zcbor_list_start_encode(zse, count);
+
+	for (uint32_t i = 0; ok && (i < count); i++) {
+		ok = zcbor_uint32_put(zse, samples[first + i]);
+	}
+
+	ok = ok && zcbor_list_end_encode(zse, count) && zcbor_map_end_encode(zse, 5);
+
+	if (!ok) {
+		LOG_ERR("Failed to encode capture chunk %u", seq);
+		return -ENOMEM;
+	}
+
+	return app_uplink_send(APP_UPLINK_BULK, APP_UPLINK_SVC_STREAM, CAPTURE_PATH,
+			       GOLIOTH_CONTENT_TYPE_CBOR, cbor_buf, zse->payload - cbor_buf);
+}
+
+static int capture_upload(uint32_t id, uint32_t total, uint32_t rate_hz)
+{
+	uint32_t chunks = DIV_ROUND_UP(total, CONFIG_APP_CAPTURE_CHUNK_SAMPLES);
+
+	status_update(&status.chunks_total, chunks);
+
+	for (uint32_t seq = 0; seq < chunks; seq++) {
+		uint32_t first = seq * CONFIG_APP_CAPTURE_CHUNK_SAMPLES;
+		uint32_t count = MIN(CONFIG_APP_CAPTURE_CHUNK_SAMPLES, total - first);
+		k_timepoint_t deadline;
+
+		deadline = sys_timepoint_calc(K_SECONDS(CONFIG_APP_CAPTURE_UPLOAD_TIMEOUT_S));
+
+		/* Leave half of the bulk queue to regular telemetry. The queue does not
+		 * drain while disconnected or while bulk traffic is held, so give up
+		 * when a chunk cannot be queued in time.
+		 */
+		while (app_uplink_free_get(APP_UPLINK_BULK) <=
+		       CONFIG_APP_UPLINK_BULK_QUEUE_LEN / 2) {
+			if (sys_timepoint_expired(deadline)) {
+				LOG_WRN("Capture %u: no room for chunk %u in %us", id, seq,
+					CONFIG_APP_CAPTURE_UPLOAD_TIMEOUT_S);
+				return -ETIMEDOUT;
+			}
+
+			k_sleep(K_MSEC(CONFIG_APP_CAPTURE_UPLOAD_POLL_MS));
+		}
+
+		int err = capture_upload_chunk(id, seq, chunks, rate_hz, first, count);
+
+		if (err) {
+			LOG_ERR("Failed to queue capture chunk %u: %d", seq, err);
+		}
+
+		status_update(&status.chunks_sent, seq + 1);
+	}
+
+	return 0;
+}
+
+static void capture_thread(void *p1, void *p2, void *p3)
+{
+	while (true) {
+		k_sem_take(&capture_sem, K_FOREVER);
+
+		k_spinlock_key_t key = k_spin_lock(&lock);
+		uint32_t id = status.id;
+		uint32_t total = status.samples_total;
+		uint32_t rate_hz = status.rate_hz;
+
+		k_spin_unlock(&lock, key);
+
+		LOG_INF("Capture %u: sampling %u samples at %u Hz", id, total, rate_hz);
+		capture_sample(total, rate_hz);
+
+		key = k_spin_lock(&lock);
+		status.state = APP_CAPTURE_UPLOADING;
+		k_spin_unlock(&lock, key);
+
+		LOG_INF("Capture %u: uploading", id);
+
+		int err = capture_upload(id, total, rate_hz);
+
+		key = k_spin_lock(&lock);
+
+		uint32_t chunks_sent = status.chunks_sent;
+
+		status.aborted = (err != 0);
+		status.state = APP_CAPTURE_IDLE;
+
+		k_spin_unlock(&lock, key);
+
+		if (err) {
+			LOG_WRN("Capture %u: upload aborted after %u of %u chunks", id, chunks_sent,
+				DIV_ROUND_UP(total, CONFIG_APP_CAPTURE_CHUNK_SAMPLES));
+		} else {
+			LOG_INF("Capture %u: complete", id);
+		}
+	}
+}
+
+K_THREAD_DEFINE(capture_tid, CONFIG_APP_CAPTURE_STACK_SIZE, capture_thread, NULL, NULL, NULL,
+		CONFIG_APP_CAPTURE_THREAD_PRIORITY, 0, 0);
+
+int app_capture_start(uint32_t duration_s, uint32_t rate_hz, uint32_t *id)
+{
+	uint64_t total = (uint64_t)duration_s * rate_hz;
+	int err = 0;
+
+	if ((rate_hz == 0) || (rate_hz > CONFIG_APP_CAPTURE_MAX_RATE_HZ) || (total == 0) ||
+	    (total > CONFIG_APP_CAPTURE_MAX_SAMPLES)) {
+		return -EINVAL;
+	}
+
+	/* The timer period is a whole number of ticks */
+	uint32_t period_ticks = capture_period_ticks(rate_hz);
+
+	if ((period_ticks == 0) ||
+	    (abs((int32_t)(period_ticks * rate_hz) - CONFIG_SYS_CLOCK_TICKS_PER_SEC) * 100 >
+	     CONFIG_SYS_CLOCK_TICKS_PER_SEC * CAPTURE_RATE_TOLERANCE_PCT)) {
+		return -ERANGE;
+	}
+
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	if (status.state != APP_CAPTURE_IDLE) {
+		err = -EBUSY;
+	} else {
+		status.state = APP_CAPTURE_SAMPLING;
+		status.id++;
+		status.rate_hz = rate_hz;
+		status.samples = 0;
+		status.samples_total = total;
+		status.chunks_sent = 0;
+		status.chunks_total = 0;
+		status.aborted = false;
+		*id = status.id;
+	}
+
+	k_spin_unlock(&lock, key);
+
+	if (!err) {
+		k_sem_give(&capture_sem);
+	}
+
+	return err;
+}
+
+void app_capture_status_get(struct app_capture_status *capture_status)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	*capture_status = status;
+
+	k_spin_unlock(&lock, key);
+}
+
+const char *app_capture_state_name(enum app_capture_state state)
+{
+	switch (state) {
+	case APP_CAPTURE_SAMPLING:
+		return "sampling";
+	case APP_CAPTURE_UPLOADING:
+		return "uploading";
+	default:
+		return "idle";
+	}
+}
@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2026 Golioth, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/** Short high-resolution burst capture, triggered by the `start_capture` RPC.
+ *
+ * Samples are taken at the requested rate into a preallocated RAM buffer of
+ * `CONFIG_APP_CAPTURE_MAX_SAMPLES` entries. While sampling, state and bulk
+ * uplink traffic is held and logs sent to Golioth are capped at
+ * `CONFIG_APP_CAPTURE_LOG_LEVEL`, so the capture is not disturbed by network
+ * activity. Each sample is read from the sensor when it is taken.
+ * Afterwards the buffer is uploaded to the `capture` Stream path as numbered
+ * chunks of bulk (lowest priority) traffic:
+ *
+ *   {"id": 3, "seq": 0, "of": 16, "hz": 100, "s": [12, 12, 13, ...]}
+ *
+ * Progress can be queried at any time with the `get_capture_status` RPC. An
+ * upload that finds no room in the bulk queue for
+ * `CONFIG_APP_CAPTURE_UPLOAD_TIMEOUT_S` is aborted and marked as such.
+ */
+
+#ifndef __APP_CAPTURE_H__
+#define __APP_CAPTURE_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+
+enum app_capture_state {
+	APP_CAPTURE_IDLE,
+	APP_CAPTURE_SAMPLING,
+	APP_CAPTURE_UPLOADING,
+};
+
+struct app_capture_status {
+	enum app_capture_state state;
+	uint32_t id;
+	uint32_t rate_hz;
+	uint32_t samples;
+	uint32_t samples_total;
+	/* Chunks handed to the uplink scheduler so far */
+	uint32_t chunks_sent;
+	uint32_t chunks_total;
+	/* Upload of the most recent capture gave up before the last chunk */
+	bool aborted;
+};
+
+/**
+ * Start a capture in the background.
+ *
+ * @retval 0 capture started, `id` holds its identifier
+ * @retval -EINVAL rate or total sample count out of range
+ * @retval -ERANGE rate not reproducible within 1% by a timer period of whole
+ *                 system clock ticks
+ * @retval -EBUSY another capture is still sampling or uploading
+ */
+int app_capture_start(uint32_t duration_s, uint32_t rate_hz, uint32_t *id);
+void app_capture_status_get(struct app_capture_status *status);
+const char *app_capture_state_name(enum app_capture_state state);
+
+#endif /* __APP_CAPTURE_H__ */
@@ -0,0 +1,205 @@
+/*
+ * Copyright (c) 2026 Golioth, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <zcbor_decode.h>
+#include <zcbor_encode.h>
+#include <zephyr/data/json.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/printk.h>
+
+#include "app_codec.h"
+#include "app_perf.h"
+#include "json_helper.h"
+
+/* Major type 0 (unsigned integer), argument in the following 4 bytes */
+#define CBOR_UINT32_HEADER 0x1a
+
+#define STATE_FMT "{\"example_int0\":%d,\"example_int1\":%d}"
+
+BUILD_ASSERT(APP_CODEC_STATE_MAX_LEN >= sizeof(STATE_FMT) - 4 + 2 * (sizeof("-2147483648") - 1),
+	     "Actual state must fit for any value");
+
+int app_codec_sample_encode(const char *key, uint32_t value, uint8_t *buf, size_t len,
+			    size_t *encoded_len)
+{
+	APP_PERF_START(encode);
+
+	ZCBOR_STATE_E(zse, 1, buf, len, 1);
+
+	bool ok = zcbor_map_start_encode(zse, 1) && zcbor_tstr_put_term(zse, key, SIZE_MAX) &&
+		  zcbor_uint32_put(zse, value) && zcbor_map_end_encode(zse, 1);
+
+	if (!ok) {
+		return -ENOMEM;
+	}
+
+	*encoded_len = zse->payload - buf;
+
+	APP_PERF_STOP(encode, APP_PERF_SENSOR_ENCODE, *encoded_len);
+
+	return 0;
+}
+
+bool app_codec_age_put(zcbor_state_t *zse, uint32_t age_s)
+{
+	/* zcbor always picks the shortest encoding, write the fixed one directly */
+	if ((zse->payload_end - zse->payload) < APP_CODEC_AGE_LEN) {
+		return false;
+	}
+
+	zse->payload_mut[0] = CBOR_UINT32_HEADER;
+	sys_put_be32(age_s, &zse->payload_mut[1]);
+	zse->payload_mut += APP_CODEC_AGE_LEN;
+	zse->elem_count++;
+
+	return true;
+}
+
+int app_codec_age_add(uint8_t *buf, size_t len, size_t offset, uint32_t elapsed_s)
+{
+	if ((offset + APP_CODEC_AGE_LEN > len) || (buf[offset] != CBOR_UINT32_HEADER)) {
+		return -EINVAL;
+	}
+
+	sys_put_be32(sys_get_be32(&buf[offset + 1]) + elapsed_s, &buf[offset + 1]);
+
+	return 0;
+}
+
+int app_codec_state_format(char *buf, size_t len, int32_t example_int0, int32_t example_int1)
+{
+	APP_PERF_START(format);
+
+	int ret = snprintk(buf, len, STATE_FMT, example_int0, example_int1);
+
+	if ((ret < 0) || (ret >= len)) {
+		return -ENOMEM;
+	}
+
+	APP_PERF_STOP(format, APP_PERF_STATE_FORMAT, ret);
+
+	return ret;
+}
+
+static void desired_check(int32_t value, uint8_t field, struct app_codec_desired *desired)
+{
+	desired->present |= field;
+
+	if (value == -1) {
+		/* No change requested */
+		return;
+	}
+
+	desired->processed |= field;
+
+	if ((value >= 0) && (value < 65536)) {
+		desired->valid |= field;
+	}
+}
+
+int app_codec_desired_decode(const uint8_t *payload, size_t len,
+			     struct app_codec_desired *desired)
+{
+	struct app_state parsed;
+	int ret;
+
+	APP_PERF_START(parse);
+
+	memset(desired, 0, sizeof(*desired));
+
+	ret = json_obj_parse((char *)payload, len, app_state_descr, ARRAY_SIZE(app_state_descr),
+			     &parsed);
+	if (ret < 0) {
+		return ret;
+	}
+
+	if (ret & APP_CODEC_DESIRED_INT0) {
+		desired->example_int0 = parsed.example_int0;
+		desired_check(parsed.example_int0, APP_CODEC_DESIRED_INT0, desired);
+	}
+
+	if (ret & APP_CODEC_DESIRED_INT1) {
+		desired->example_int1 = parsed.example_int1;
+		desired_check(parsed.example_int1, APP_CODEC_DESIRED_INT1, desired);
+	}
+
+	APP_PERF_STOP(parse, APP_PERF_STATE_PARSE, len);
+
+	return 0;
+}
+
+int app_codec_loop_delay_check(int32_t loop_delay_s)
+{
+	if ((loop_delay_s < APP_CODEC_LOOP_DELAY_S_MIN) ||
+	    (loop_delay_s > APP_CODEC_LOOP_DELAY_S_MAX)) {
+		return -ERANGE;
+	}
+
+	return 0;
+}
+
+/* The console may send whole numbers either as integers or as floats */
+static bool decode_number(zcbor_state_t *zsd, double *value)
+{
+	int32_t int_value;
+
+	if (zcbor_int32_decode(zsd, &int_value)) {
+		*value = int_value;
+		return true;
+	}
+
+	return zcbor_float_decode(zsd, value);
+}
+
+int app_codec_log_level_decode(zcbor_state_t *params, uint8_t *level)
+{
+	const uint8_t *params_start __maybe_unused = params->payload;
+	double value;
+
+	APP_PERF_START(decode);
+
+	if (!zcbor_float_decode(params, &value)) {
+		return -EBADMSG;
+	}
+
+	APP_PERF_STOP(decode, APP_PERF_RPC_DECODE, params->payload - params_start);
+
+	/* Reject NaN and out of range values before the cast, which is undefined for them */
+	if (!(value >= LOG_LEVEL_NONE) || (value > LOG_LEVEL_DBG)) {
+		return -ERANGE;
+	}
+
+	*level = (uint8_t)value;
+
+	return 0;
+}
+
+int app_codec_capture_decode(zcbor_state_t *params, uint32_t *duration_s, uint32_t *rate_hz)
+{
+	const uint8_t *params_start __maybe_unused = params->payload;
+	double duration;
+	double rate;
+
+	APP_PERF_START(decode);
+
+	if (!decode_number(params, &duration) || !decode_number(params, &rate)) {
+		return -EBADMSG;
+	}
+
+	APP_PERF_STOP(decode, APP_PERF_CAPTURE_DECODE, params->payload - params_start);
+
+	if (!(duration >= 1) || !(rate >= 1) || (duration > UINT16_MAX) || (rate > UINT16_MAX)) {
+		return -ERANGE;
+	}
+
+	*duration_s = (uint32_t)duration;
+	*rate_hz = (uint32_t)rate;
+
+	return 0;
+}
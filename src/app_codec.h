@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2026 Golioth, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/** Encoders and decoders of the application's payloads.
+ *
+ * These are the hot paths between the Golioth services and the application:
+ * the CBOR sensor reading, the desired state JSON and its validation, the
+ * actual state JSON, the `LOOP_DELAY_S` setting and the RPC parameters. They
+ * only depend on Zephyr's JSON library and zcbor, so the unit tests,
+ * benchmarks and fuzzers in `tests/` exercise the same code as the firmware.
+ *
+ * Every encoder and decoder is wrapped in an `APP_PERF` probe (see app_perf.h).
+ */
+
+#ifndef __APP_CODEC_H__
+#define __APP_CODEC_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <zcbor_common.h>
+#include <zephyr/sys/util.h>
+
+#define APP_CODEC_STATE_MAX_LEN 64
+
+/* CBOR unsigned integer with a 4 byte argument */
+#define APP_CODEC_AGE_LEN 5
+
+#define APP_CODEC_LOOP_DELAY_S_MIN 1
+#define APP_CODEC_LOOP_DELAY_S_MAX 43200
+
+/* Desired state fields, in the order of `app_state_descr` */
+#define APP_CODEC_DESIRED_INT0 BIT(0)
+#define APP_CODEC_DESIRED_INT1 BIT(1)
+
+struct app_codec_desired {
+	int32_t example_int0;
+	int32_t example_int1;
+	/* Fields present in the document */
+	uint8_t present;
+	/* Present fields other than -1, to be reset to -1 on the server */
+	uint8_t processed;
+	/* Processed fields holding a value in [0..65535] */
+	uint8_t valid;
+};
+
+/**
+ * Encode a sensor reading as the CBOR map `{key: value}`.
+ *
+ * @retval -ENOMEM `buf` is too small
+ */
+int app_codec_sample_encode(const char *key, uint32_t value, uint8_t *buf, size_t len,
+			    size_t *encoded_len);
+
+/**
+ * Encode an age in seconds at full width, so it can be advanced in place with
+ * `app_codec_age_add()` until the payload is sent.
+ *
+ * @return false if `zse` has no room for `APP_CODEC_AGE_LEN` bytes
+ */
+bool app_codec_age_put(zcbor_state_t *zse, uint32_t age_s);
+
+/**
+ * Advance an age encoded by `app_codec_age_put()` at `offset` in `buf`.
+ *
+ * @retval -EINVAL no full width unsigned integer at `offset`
+ */
+int app_codec_age_add(uint8_t *buf, size_t len, size_t offset, uint32_t elapsed_s);
+
+/**
+ * Format the actual state as JSON, NUL terminated.
+ *
+ * @return length of the JSON without the terminator
+ * @retval -ENOMEM `buf` is too small
+ */
+int app_codec_state_format(char *buf, size_t len, int32_t example_int0, int32_t example_int1);
+
+/**
+ * Parse and validate a desired state JSON document.
+ *
+ * @retval 0 `desired` describes which fields were present and valid
+ * @retval <0 JSON error from `json_obj_parse()`
+ */
+int app_codec_desired_decode(const uint8_t *payload, size_t len,
+			     struct app_codec_desired *desired);
+
+/**
+ * Validate a `LOOP_DELAY_S` setting.
+ *
+ * @retval -ERANGE outside of [APP_CODEC_LOOP_DELAY_S_MIN..APP_CODEC_LOOP_DELAY_S_MAX]
+ */
+int app_codec_loop_delay_check(int32_t loop_delay_s);
+
+/**
+ * Decode the parameters of the `set_log_level` RPC: one number in [0..4].
+ *
+ * @retval -EBADMSG parameter missing or not a number
+ * @retval -ERANGE NaN or out of range
+ */
+int app_codec_log_level_decode(zcbor_state_t *params, uint8_t *level);
+
+/**
+ * Decode the parameters of the `start_capture` RPC: duration and rate, each a
+ * number in [1..65535].
+ *
+ * @retval -EBADMSG parameter missing or not a number
+ * @retval -ERANGE NaN or out of range
+ */
+int app_codec_capture_decode(zcbor_state_t *params, uint32_t *duration_s, uint32_t *rate_hz);
+
+#endif /* __APP_CODEC_H__ */
@@ -0,0 +1,259 @@
+/*
+ * Copyright (c) 2026 Golioth, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(app_conn, LOG_LEVEL_DBG);
+
+#include <zephyr/kernel.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/spinlock.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/zbus/zbus.h>
+
+#ifdef CONFIG_NET_SOCKETS_SOCKOPT_TLS
+/* Session fields are private in mbedTLS 3 */
+#define MBEDTLS_ALLOW_PRIVATE_ACCESS
+#include <string.h>
+#include <mbedtls/platform_util.h>
+#include <mbedtls/ssl.h>
+#endif
+
+#include "app_bus.h"
+#include "app_conn.h"
+#include "app_ota.h"
+
+#ifdef CONFIG_APP_LINK_SIM
+#include "app_link_sim.h"
+#endif
+
+enum handshake_kind {
+	HANDSHAKE_UNCLASSIFIED,
+	HANDSHAKE_FULL,
+	HANDSHAKE_ABBREVIATED,
+};
+
+struct handshake_stats {
+	uint32_t count;
+	uint32_t max_ms;
+	uint64_t sum_ms;
+};
+
+static struct handshake_stats full;
+static struct handshake_stats abbreviated;
+static uint32_t unclassified;
+static uint32_t failed;
+static uint32_t connects;
+static uint32_t disconnects;
+static uint32_t last_handshake_ms;
+static struct k_spinlock lock;
+
+/* Outcome of the last completed handshake as seen by the TLS stack */
+static atomic_t handshake_kind = ATOMIC_INIT(HANDSHAKE_UNCLASSIFIED);
+
+/* DTLS socket of the Golioth client, carrying plaintext CoAP at this layer */
+static atomic_t client_sock = ATOMIC_INIT(-1);
+
+#ifdef CONFIG_NET_SOCKETS_SOCKOPT_TLS
+/*
+ * Zephyr restores a cached session with mbedtls_ssl_set_session() before the
+ * handshake. The server resumed it if the negotiated session still has the
+ * same master secret afterwards; a full handshake derives a new one. Both
+ * calls are made by the thread connecting the socket.
+ */
+static unsigned char offered_master[48];
+static bool offered;
+
+int __real_mbedtls_ssl_set_session(mbedtls_ssl_context *ssl, const mbedtls_ssl_session *session);
+int __real_mbedtls_ssl_handshake(mbedtls_ssl_context *ssl);
+
+int __wrap_mbedtls_ssl_set_session(mbedtls_ssl_context *ssl, const mbedtls_ssl_session *session)
+{
+	int ret = __real_mbedtls_ssl_set_session(ssl, session);
+
+	if (ret == 0) {
+		memcpy(offered_master, session->master, sizeof(offered_master));
+		offered = true;
+	}
+
+	return ret;
+}
+
+int __wrap_mbedtls_ssl_handshake(mbedtls_ssl_context *ssl)
+{
+	int ret = __real_mbedtls_ssl_handshake(ssl);
+
+	if ((ret == MBEDTLS_ERR_SSL_WANT_READ) || (ret == MBEDTLS_ERR_SSL_WANT_WRITE)) {
+		return ret;
+	}
+
+	if (ret == 0) {
+		bool resumed = offered && (ssl->session != NULL) &&
+			       (memcmp(ssl->session->master, offered_master,
+				       sizeof(offered_master)) == 0);
+
+		atomic_set(&handshake_kind, resumed ? HANDSHAKE_ABBREVIATED : HANDSHAKE_FULL);
+	}
+
+	mbedtls_platform_zeroize(offered_master, sizeof(offered_master));
+	offered = false;
+
+	return ret;
+}
+#endif /* CONFIG_NET_SOCKETS_SOCKOPT_TLS */
+
+static const char *handshake_kind_name(enum handshake_kind kind)
+{
+	switch (kind) {
+	case HANDSHAKE_FULL:
+		return "full";
+	case HANDSHAKE_ABBREVIATED:
+		return "abbreviated";
+	default:
+		return "unclassified";
+	}
+}
+
+static void handshake_record(enum handshake_kind kind, uint32_t duration_ms)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	struct handshake_stats *hs = NULL;
+
+	if (kind == HANDSHAKE_FULL) {
+		hs = &full;
+	} else if (kind == HANDSHAKE_ABBREVIATED) {
+		hs = &abbreviated;
+	} else {
+		unclassified++;
+	}
+
+	if (hs) {
+		hs->count++;
+		hs->sum_ms += duration_ms;
+		hs->max_ms = MAX(hs->max_ms, duration_ms);
+	}
+	last_handshake_ms = duration_ms;
+
+	k_spin_unlock(&lock, key);
+}
+
+/*
+ * The Golioth client connects its DTLS socket with zsock_connect(), which
+ * runs the handshake. Wrapping it enables the client session cache on that
+ * socket and times the handshake alone, without DNS lookups, the outage or
+ * the client's reconnect back-off.
+ */
+int __real_z_impl_zsock_connect(int sock, const struct sockaddr *addr, socklen_t addrlen);
+
+int __wrap_z_impl_zsock_connect(int sock, const struct sockaddr *addr, socklen_t addrlen)
+{
+	int cache = TLS_SESSION_CACHE_ENABLED;
+
+	if (zsock_setsockopt(sock, SOL_TLS, TLS_SESSION_CACHE, &cache, sizeof(cache)) < 0) {
+		/* Not a (D)TLS socket */
+		return __real_z_impl_zsock_connect(sock, addr, addrlen);
+	}
+
+	atomic_set(&handshake_kind, HANDSHAKE_UNCLASSIFIED);
+
+	int64_t start = k_uptime_get();
+	int ret = __real_z_impl_zsock_connect(sock, addr, addrlen);
+	uint32_t duration_ms = (uint32_t)(k_uptime_get() - start);
+
+	if (ret == 0) {
+		atomic_set(&client_sock, sock);
+	}
+
+	if (ret < 0) {
+		k_spinlock_key_t key = k_spin_lock(&lock);
+
+		failed++;
+		k_spin_unlock(&lock, key);
+
+		LOG_WRN("Handshake failed after %u ms", duration_ms);
+		return ret;
+	}
+
+	enum handshake_kind kind = atomic_get(&handshake_kind);
+
+	handshake_record(kind, duration_ms);
+
+	LOG_INF("Handshake completed in %u ms (%s)", duration_ms, handshake_kind_name(kind));
+
+	return ret;
+}
+
+/*
+ * The client sends and receives each CoAP message with zsock_send() and
+ * zsock_recv() on its DTLS socket. This covers all of its traffic: queued
+ * uplinks, direct sends, logs, RPC responses, observations and keepalives.
+ */
+ssize_t __real_z_impl_zsock_sendto(int sock, const void *buf, size_t len, int flags,
+				   const struct sockaddr *dest_addr, socklen_t addrlen);
+ssize_t __real_z_impl_zsock_recvfrom(int sock, void *buf, size_t max_len, int flags,
+				     struct sockaddr *src_addr, socklen_t *addrlen);
+
+ssize_t __wrap_z_impl_zsock_sendto(int sock, const void *buf, size_t len, int flags,
+				   const struct sockaddr *dest_addr, socklen_t addrlen)
+{
+	ssize_t ret = __real_z_impl_zsock_sendto(sock, buf, len, flags, dest_addr, addrlen);
+
+	if ((ret > 0) && (sock == atomic_get(&client_sock))) {
+		app_ota_coap_sent(buf, ret);
+		IF_ENABLED(CONFIG_APP_LINK_SIM, (app_link_sim_tx(ret);));
+	}
+
+	return ret;
+}
+
+ssize_t __wrap_z_impl_zsock_recvfrom(int sock, void *buf, size_t max_len, int flags,
+				     struct sockaddr *src_addr, socklen_t *addrlen)
+{
+	ssize_t ret = __real_z_impl_zsock_recvfrom(sock, buf, max_len, flags, src_addr, addrlen);
+
+	if ((ret > 0) && (sock == atomic_get(&client_sock))) {
+		IF_ENABLED(CONFIG_APP_LINK_SIM, (app_link_sim_rx(ret);));
+	}
+
+	return ret;
+}
+
+/* Runs in the thread publishing the event */
+static void conn_event_cb(const struct zbus_channel *chan)
+{
+	const struct app_bus_conn *conn = zbus_chan_const_msg(chan);
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	if (conn->connected) {
+		connects++;
+	} else {
+		disconnects++;
+	}
+
+	k_spin_unlock(&lock, key);
+}
+
+ZBUS_LISTENER_DEFINE(conn_event_lis, conn_event_cb);
+ZBUS_CHAN_ADD_OBS(app_conn_chan, conn_event_lis, 0);
+
+void app_conn_stats_get(struct app_conn_stats *stats)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	stats->connects = connects;
+	stats->disconnects = disconnects;
+	stats->full_handshakes = full.count;
+	stats->full_avg_ms = full.count ? (full.sum_ms / full.count) : 0;
+	stats->full_max_ms = full.max_ms;
+	stats->abbreviated_handshakes = abbreviated.count;
+	stats->abbreviated_avg_ms =
+		abbreviated.count ? (abbreviated.sum_ms / abbreviated.count) : 0;
+	stats->abbreviated_max_ms = abbreviated.max_ms;
+	stats->unclassified_handshakes = unclassified;
+	stats->failed_handshakes = failed;
+	stats->last_handshake_ms = last_handshake_ms;
+
+	k_spin_unlock(&lock, key);
+}
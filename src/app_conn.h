@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) 2026 Golioth, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/** Connection statistics for the Golioth client.
+ *
+ * The client's DTLS connect is wrapped at link time (`--wrap` in
+ * CMakeLists.txt) to enable the Zephyr TLS client session cache on its
+ * socket and to time the handshake alone, excluding the outage and reconnect
+ * back-off. A handshake is counted as abbreviated when mbedTLS resumed the
+ * cached session and as full otherwise; without the Zephyr TLS sockets (e.g.
+ * TLS offloaded to a modem) it is counted as unclassified. Connects and
+ * disconnects are counted from `app_conn_chan` (see app_bus.h).
+ *
+ * Sends and receives on the client socket are wrapped too, passing each
+ * plaintext CoAP message to the modules that inspect client traffic (see
+ * app_ota.h and app_link_sim.h).
+ *
+ * With DTLS Connection ID enabled (`CONFIG_GOLIOTH_USE_CONNECTION_ID`) a NAT
+ * rebinding no longer breaks the session, so it does not show up here as a
+ * disconnect at all.
+ */
+
+#ifndef __APP_CONN_H__
+#define __APP_CONN_H__
+
+#include <stdint.h>
+
+struct app_conn_stats {
+	uint32_t connects;
+	uint32_t disconnects;
+	uint32_t full_handshakes;
+	uint32_t full_avg_ms;
+	uint32_t full_max_ms;
+	uint32_t abbreviated_handshakes;
+	uint32_t abbreviated_avg_ms;
+	uint32_t abbreviated_max_ms;
+	uint32_t unclassified_handshakes;
+	uint32_t failed_handshakes;
+	uint32_t last_handshake_ms;
+};
+
+void app_conn_stats_get(struct app_conn_stats *stats);
+
+#endif /* __APP_CONN_H__ */
@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2026 Golioth, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(app_display, LOG_LEVEL_DBG);
+
+#include <libostentus.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/zbus/zbus.h>
+
+#ifdef CONFIG_ALUDEL_BATTERY_MONITOR
+#include <battery_monitor.h>
+#endif
+
+#include "app_bus.h"
+#include "app_sensors.h"
+
+static const struct device *o_dev = DEVICE_DT_GET_ANY(golioth_ostentus);
+
+static void display_sample(const struct app_bus_sample *sample)
+{
+	uint16_t counter = sample->counter;
+	char sbuf[32];
+
+	/* Update slide values on Ostentus
+	 *  -values should be sent as strings
+	 *  -use the enum from app_sensors.h for slide key values
+	 */
+	snprintk(sbuf, sizeof(sbuf), "%d", counter);
+	ostentus_slide_set(o_dev, UP_COUNTER, sbuf, strlen(sbuf));
+	snprintk(sbuf, sizeof(sbuf), "%d", 65535 - counter);
+	ostentus_slide_set(o_dev, DN_COUNTER, sbuf, strlen(sbuf));
+
+	/* The battery is read right before each sample is published */
+	IF_ENABLED(CONFIG_ALUDEL_BATTERY_MONITOR, (
+		ostentus_slide_set(o_dev,
+				   BATTERY_V,
+				   get_batt_v_str(),
+				   strlen(get_batt_v_str()));
+		ostentus_slide_set(o_dev,
+				   BATTERY_PCT,
+				   get_batt_pct_str(),
+				   strlen(get_batt_pct_str()));
+	));
+}
+
+ZBUS_MSG_SUBSCRIBER_DEFINE(display_sub);
+ZBUS_CHAN_ADD_OBS(app_sample_chan, display_sub, 2);
+
+/* Display observer, keeps slow I2C transfers off the producer threads */
+static void display_thread(void *p1, void *p2, void *p3)
+{
+	const struct zbus_channel *chan;
+	struct app_bus_sample sample;
+
+	while (zbus_sub_wait_msg(&display_sub, &chan, &sample, K_FOREVER) == 0) {
+		if (chan == &app_sample_chan) {
+			display_sample(&sample);
+		}
+	}
+}
+
+K_THREAD_DEFINE(display_tid, CONFIG_APP_BUS_OBSERVER_STACK_SIZE, display_thread, NULL, NULL, NULL,
+		CONFIG_APP_BUS_OBSERVER_THREAD_PRIORITY, 0, 0);
@@ -0,0 +1,246 @@
+/*
+ * Copyright (c) 2026 Golioth, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(app_fleet_sim, LOG_LEVEL_DBG);
+
+#include <stdarg.h>
+#include <string.h>
+#include <golioth/client.h>
+#include <zephyr/kernel.h>
+#include <zephyr/random/random.h>
+#include <zephyr/settings/settings.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/zbus/zbus.h>
+
+#include <cmdline.h>
+#include <posix_native_task.h>
+
+#include "app_bus.h"
+#include "app_conn.h"
+#include "app_fleet_sim.h"
+#include "app_settings.h"
+#include "app_uplink.h"
+
+static char *psk_id;
+static char *psk;
+static int loop_delay_s = -1;
+static int start_jitter_ms;
+static int link_down_at_s = -1;
+static int link_down_for_s = 30;
+static int link_down_period_s;
+
+static struct golioth_client *client;
+
+static void fleet_sim_options(void)
+{
+	static struct args_struct_t options[] = {
+		{
+			.option = "psk-id",
+			.name = "id",
+			.type = 's',
+			.dest = (void *)&psk_id,
+			.descript = "Golioth PSK-ID of this instance",
+		},
+		{
+			.option = "psk",
+			.name = "psk",
+			.type = 's',
+			.dest = (void *)&psk,
+			.descript = "Golioth PSK of this instance",
+		},
+		{
+			.option = "loop-delay-s",
+			.name = "s",
+			.type = 'i',
+			.dest = (void *)&loop_delay_s,
+			.descript = "Initial LOOP_DELAY_S",
+		},
+		{
+			.option = "start-jitter-ms",
+			.name = "ms",
+			.type = 'i',
+			.dest = (void *)&start_jitter_ms,
+			.descript = "Maximum random delay before starting the Golioth client",
+		},
+		{
+			.option = "link-down-at-s",
+			.name = "s",
+			.type = 'i',
+			.dest = (void *)&link_down_at_s,
+			.descript = "Uptime at which the Golioth client is stopped",
+		},
+		{
+			.option = "link-down-for-s",
+			.name = "s",
+			.type = 'i',
+			.dest = (void *)&link_down_for_s,
+			.descript = "Time the Golioth client stays stopped (default 30)",
+		},
+		{
+			.option = "link-down-period-s",
+			.name = "s",
+			.type = 'i',
+			.dest = (void *)&link_down_period_s,
+			.descript = "Repeat the link loss with this period (default: once)",
+		},
+		ARG_TABLE_ENDMARKER,
+	};
+
+	native_add_command_line_opts(options);
+}
+NATIVE_TASK(fleet_sim_options, PRE_BOOT_1, 1);
+
+static void fleet_sim_event(const char *event)
+{
+	printk("{\"fleet_event\":\"%s\",\"uptime_ms\":%u}\n", event, k_uptime_get_32());
+}
+
+static void fleet_sim_link_work_handler(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(fleet_sim_link_work, fleet_sim_link_work_handler);
+
+static void fleet_sim_link_work_handler(struct k_work *work)
+{
+	static bool link_down;
+
+	if (!link_down) {
+		fleet_sim_event("link_down");
+		golioth_client_stop(client);
+		link_down = true;
+		k_work_schedule(&fleet_sim_link_work, K_SECONDS(link_down_for_s));
+		return;
+	}
+
+	fleet_sim_event("link_up");
+	golioth_client_start(client);
+	link_down = false;
+
+	if (link_down_period_s > link_down_for_s) {
+		k_work_schedule(&fleet_sim_link_work,
+				K_SECONDS(link_down_period_s - link_down_for_s));
+	}
+}
+
+static void fleet_sim_report_work_handler(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(fleet_sim_report_work, fleet_sim_report_work_handler);
+
+/* Appends to buf, leaving len at most size - 1 when the output is truncated */
+static __printf_like(4, 5) void fleet_sim_append(char *buf, size_t size, size_t *len,
+						 const char *fmt, ...)
+{
+	va_list ap;
+	int ret;
+
+	if (*len >= size - 1) {
+		return;
+	}
+
+	va_start(ap, fmt);
+	ret = vsnprintk(&buf[*len], size - *len, fmt, ap);
+	va_end(ap);
+
+	if (ret > 0) {
+		*len = MIN(*len + ret, size - 1);
+	}
+}
+
+static void fleet_sim_report_work_handler(struct k_work *work)
+{
+	/* Built in one buffer so the line is not interleaved with log output */
+	static char buf[1024];
+	struct app_uplink_stats stats;
+	struct app_conn_stats conn;
+	size_t len = 0;
+
+	app_conn_stats_get(&conn);
+
+	fleet_sim_append(buf, sizeof(buf), &len,
+			 "{\"fleet\":{\"uptime_ms\":%u,\"connects\":%u,\"disconnects\":%u,"
+			 "\"handshakes\":{\"full\":%u,\"abbreviated\":%u,\"unclassified\":%u,"
+			 "\"failed\":%u,\"full_avg_ms\":%u,\"abbreviated_avg_ms\":%u}",
+			 k_uptime_get_32(), conn.connects, conn.disconnects, conn.full_handshakes,
+			 conn.abbreviated_handshakes, conn.unclassified_handshakes,
+			 conn.failed_handshakes, conn.full_avg_ms, conn.abbreviated_avg_ms);
+
+	for (int i = 0; i < APP_UPLINK_CLASS_COUNT; i++) {
+		app_uplink_stats_get(i, &stats);
+
+		fleet_sim_append(buf, sizeof(buf), &len,
+				 ",\"%s\":{\"sent\":%u,\"failed\":%u,\"dropped\":%u,"
+				 "\"bytes\":%u,\"hist\":[",
+				 app_uplink_class_name(i), stats.sent, stats.failed, stats.dropped,
+				 stats.bytes);
+		for (int b = 0; b < APP_UPLINK_LATENCY_BUCKETS; b++) {
+			fleet_sim_append(buf, sizeof(buf), &len, "%s%u", b ? "," : "",
+					 stats.latency_hist[b]);
+		}
+		fleet_sim_append(buf, sizeof(buf), &len, "]}");
+	}
+
+	if (len >= sizeof(buf) - 1) {
+		/* A cut-off line would not parse, skip it */
+		LOG_WRN("Fleet report exceeds %zu bytes", sizeof(buf) - 1);
+	} else {
+		printk("%s}}\n", buf);
+	}
+
+	k_work_schedule(&fleet_sim_report_work, K_SECONDS(CONFIG_APP_FLEET_SIM_REPORT_INTERVAL_S));
+}
+
+void app_fleet_sim_init(void)
+{
+	int err;
+
+	if (psk_id) {
+		err = settings_runtime_set("golioth/psk-id", psk_id, strlen(psk_id));
+		if (err) {
+			LOG_ERR("Failed to apply PSK-ID: %d", err);
+		}
+	}
+
+	if (psk) {
+		err = settings_runtime_set("golioth/psk", psk, strlen(psk));
+		if (err) {
+			LOG_ERR("Failed to apply PSK: %d", err);
+		}
+	}
+
+	if (loop_delay_s > 0) {
+		set_loop_delay_s(loop_delay_s);
+	}
+
+	if (start_jitter_ms > 0) {
+		uint32_t delay_ms = sys_rand32_get() % (start_jitter_ms + 1);
+
+		LOG_INF("Delaying start by %u ms", delay_ms);
+		k_msleep(delay_ms);
+	}
+
+	fleet_sim_event("start");
+	k_work_schedule(&fleet_sim_report_work, K_SECONDS(CONFIG_APP_FLEET_SIM_REPORT_INTERVAL_S));
+}
+
+void app_fleet_sim_set_client(struct golioth_client *sim_client)
+{
+	client = sim_client;
+
+	if (link_down_at_s >= 0) {
+		int64_t remaining_ms = (int64_t)link_down_at_s * MSEC_PER_SEC - k_uptime_get();
+
+		k_work_schedule(&fleet_sim_link_work, K_MSEC(MAX(remaining_ms, 0)));
+	}
+}
+
+static void fleet_sim_conn_cb(const struct zbus_channel *chan)
+{
+	const struct app_bus_conn *conn = zbus_chan_const_msg(chan);
+
+	/* Counted by app_conn, reported in the periodic fleet report */
+	fleet_sim_event(conn->connected ? "connected" : "disconnected");
+}
+
+ZBUS_LISTENER_DEFINE(fleet_sim_conn_lis, fleet_sim_conn_cb);
+ZBUS_CHAN_ADD_OBS(app_conn_chan, fleet_sim_conn_lis, 0);
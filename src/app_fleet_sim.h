@@ -0,0 +1,34 @@
+/*
+ * Copyright (c) 2026 Golioth, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/** Support for running many native_sim instances of this application as a
+ * simulated fleet (see scripts/fleet_sim.py).
+ *
+ * Each instance accepts the following command line options:
+ *
+ * - `--psk-id=<id>` / `--psk=<psk>`: credentials applied on top of the sample
+ *   settings, so every instance can use its own device.
+ * - `--loop-delay-s=<s>`: initial `LOOP_DELAY_S` until the Settings Service
+ *   provides a value.
+ * - `--start-jitter-ms=<ms>`: wait a random time up to this value before
+ *   starting the Golioth client.
+ * - `--link-down-at-s=<s>`, `--link-down-for-s=<s>`, `--link-down-period-s=<s>`:
+ *   stop the Golioth client at the given uptime for the given duration,
+ *   optionally repeating with the given period.
+ *
+ * Connection events, uplink counters and DTLS handshake counts are printed as
+ * one JSON object per line for the harness to aggregate.
+ */
+
+#ifndef __APP_FLEET_SIM_H__
+#define __APP_FLEET_SIM_H__
+
+#include <golioth/client.h>
+
+void app_fleet_sim_init(void);
+void app_fleet_sim_set_client(struct golioth_client *sim_client);
+
+#endif /* __APP_FLEET_SIM_H__ */
@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2026 Golioth, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(app_link_sim, LOG_LEVEL_DBG);
+
+#include <zephyr/kernel.h>
+#include <zephyr/spinlock.h>
+#include <zephyr/sys/printk.h>
+
+#include <cmdline.h>
+#include <posix_native_task.h>
+
+#include "app_link_sim.h"
+#ifdef CONFIG_APP_TXWIN
+#include "app_txwin.h"
+#endif
+
+static int txwin_period_s = -1;
+static int tail_ms = CONFIG_APP_LINK_SIM_TAIL_MS;
+static int tau_s = CONFIG_APP_LINK_SIM_TAU_S;
+
+/* The current (or last) connected period runs from conn_start to conn_end */
+static int64_t conn_start;
+static int64_t conn_end;
+static uint64_t connected_ms;
+static uint32_t promotions;
+static uint32_t tx_count;
+static uint32_t tx_bytes;
+static uint32_t rx_count;
+static uint32_t rx_bytes;
+static struct k_spinlock lock;
+
+static void link_sim_options(void)
+{
+	static struct args_struct_t options[] = {
+		{
+			.option = "txwin-period-s",
+			.name = "s",
+			.type = 'i',
+			.dest = (void *)&txwin_period_s,
+			.descript = "Transmit window period, 0 disables windows",
+		},
+		{
+			.option = "link-tail-ms",
+			.name = "ms",
+			.type = 'i',
+			.dest = (void *)&tail_ms,
+			.descript = "RRC inactivity timer of the simulated network",
+		},
+		{
+			.option = "link-tau-s",
+			.name = "s",
+			.type = 'i',
+			.dest = (void *)&tau_s,
+			.descript = "Period of network initiated wake-ups (default: none)",
+		},
+		ARG_TABLE_ENDMARKER,
+	};
+
+	native_add_command_line_opts(options);
+}
+NATIVE_TASK(link_sim_options, PRE_BOOT_1, 1);
+
+/* Keep the radio connected for another tail, promoting it if it was idle */
+static void link_sim_activity(int64_t now)
+{
+	bool promoted = false;
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	if (now >= conn_end) {
+		connected_ms += conn_end - conn_start;
+		conn_start = now;
+		promotions++;
+		promoted = true;
+	}
+	conn_end = now + tail_ms;
+
+	k_spin_unlock(&lock, key);
+
+	if (promoted) {
+		IF_ENABLED(CONFIG_APP_TXWIN, (app_txwin_radio_active();));
+	}
+}
+
+void app_link_sim_tx(size_t len)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	tx_count++;
+	tx_bytes += len;
+
+	k_spin_unlock(&lock, key);
+
+	link_sim_activity(k_uptime_get());
+}
+
+/* Downlink pages the radio into connected mode as well */
+void app_link_sim_rx(size_t len)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	rx_count++;
+	rx_bytes += len;
+
+	k_spin_unlock(&lock, key);
+
+	link_sim_activity(k_uptime_get());
+}
+
+static void link_sim_tau_work_handler(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(link_sim_tau_work, link_sim_tau_work_handler);
+
+static void link_sim_tau_work_handler(struct k_work *work)
+{
+	link_sim_activity(k_uptime_get());
+	k_work_schedule(&link_sim_tau_work, K_SECONDS(tau_s));
+}
+
+static void link_sim_report_work_handler(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(link_sim_report_work, link_sim_report_work_handler);
+
+static void link_sim_report_work_handler(struct k_work *work)
+{
+	int64_t now = k_uptime_get();
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	uint64_t conn_ms = connected_ms + (MIN(now, conn_end) - conn_start);
+	uint32_t promoted = promotions;
+	uint32_t sent = tx_count;
+	uint32_t sent_bytes = tx_bytes;
+	uint32_t received = rx_count;
+	uint32_t received_bytes = rx_bytes;
+
+	k_spin_unlock(&lock, key);
+
+	/* Charge in uA*ms */
+	uint64_t charge = (uint64_t)(now - conn_ms) * CONFIG_APP_LINK_SIM_IDLE_UA +
+			  conn_ms * CONFIG_APP_LINK_SIM_CONNECTED_UA +
+			  (uint64_t)sent * CONFIG_APP_LINK_SIM_TX_MS * CONFIG_APP_LINK_SIM_TX_UA;
+	uint32_t windows = 0;
+	uint32_t piggybacked = 0;
+
+#ifdef CONFIG_APP_TXWIN
+	struct app_txwin_stats txwin;
+
+	app_txwin_stats_get(&txwin);
+	windows = txwin.windows;
+	piggybacked = txwin.piggybacked;
+#endif
+
+	printk("{\"link\":{\"uptime_ms\":%u,\"connected_ms\":%u,\"promotions\":%u,\"tx\":%u,"
+	       "\"tx_bytes\":%u,\"rx\":%u,\"rx_bytes\":%u,\"charge_uah\":%u,\"avg_ua\":%u,"
+	       "\"windows\":%u,\"piggybacked\":%u}}\n",
+	       (uint32_t)now, (uint32_t)conn_ms, promoted, sent, sent_bytes, received,
+	       received_bytes, (uint32_t)(charge / (3600 * MSEC_PER_SEC)),
+	       (uint32_t)(charge / MAX(now, 1)), windows, piggybacked);
+
+	k_work_schedule(&link_sim_report_work, K_SECONDS(CONFIG_APP_LINK_SIM_REPORT_INTERVAL_S));
+}
+
+void app_link_sim_init(void)
+{
+	if (txwin_period_s >= 0) {
+		IF_ENABLED(CONFIG_APP_TXWIN, (app_txwin_period_set(txwin_period_s);));
+	}
+
+	if (tau_s > 0) {
+		k_work_schedule(&link_sim_tau_work, K_SECONDS(tau_s));
+	}
+
+	k_work_schedule(&link_sim_report_work, K_SECONDS(CONFIG_APP_LINK_SIM_REPORT_INTERVAL_S));
+}
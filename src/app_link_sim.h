@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) 2026 Golioth, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/** Simulated cellular radio for measuring uplink energy on native_sim.
+ *
+ * native_sim sends over the host network, which has no radio states. This
+ * module models an LTE-M/NB-IoT radio instead: every CoAP message the Golioth
+ * client sends or receives on its socket (see app_conn.h) promotes the radio
+ * to RRC connected mode, where it stays until `CONFIG_APP_LINK_SIM_TAIL_MS`
+ * pass without further traffic. Logs, RPC responses, observe notifications
+ * and messages sent outside of the uplink scheduler are all included. Charge
+ * is accounted with the idle, connected and transmit currents from Kconfig,
+ * and each promotion is reported to the transmit window scheduler like an RRC
+ * event from the modem would be (see app_txwin.h).
+ *
+ * Each instance accepts the following command line options:
+ *
+ * - `--txwin-period-s=<s>`: transmit window period, 0 sends without windows.
+ * - `--link-tail-ms=<ms>`: RRC inactivity timer of the simulated network.
+ * - `--link-tau-s=<s>`: period of network initiated wake-ups, such as the
+ *   tracking area update at the end of a PSM cycle (default: none).
+ *
+ * A summary is printed as one JSON object per line every
+ * `CONFIG_APP_LINK_SIM_REPORT_INTERVAL_S` for scripts/fleet_sim.py to
+ * aggregate next to the uplink latency histograms.
+ */
+
+#ifndef __APP_LINK_SIM_H__
+#define __APP_LINK_SIM_H__
+
+#include <stddef.h>
+
+void app_link_sim_init(void);
+void app_link_sim_tx(size_t len);
+void app_link_sim_rx(size_t len);
+
+#endif /* __APP_LINK_SIM_H__ */
@@ -0,0 +1,280 @@
+/*
+ * Copyright (c) 2026 Golioth, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(app_ota, LOG_LEVEL_DBG);
+
+#include <string.h>
+#include <golioth/fw_update.h>
+#include <golioth/ota.h>
+#include <zephyr/kernel.h>
+#include <zephyr/net/coap.h>
+#include <zephyr/spinlock.h>
+
+#ifdef CONFIG_STREAM_FLASH
+#include <zephyr/storage/stream_flash.h>
+#endif
+
+#ifdef CONFIG_BOOTLOADER_MCUBOOT
+#include <zephyr/dfu/mcuboot.h>
+#include <zephyr/storage/flash_map.h>
+#endif
+
+#include "app_acct.h"
+#include "app_ota.h"
+#include "app_uplink.h"
+
+/* Uri-Path of component downloads: .u/c/<package>@<version> */
+#define OTA_COMPONENT_PATH_0 ".u"
+#define OTA_COMPONENT_PATH_1 "c"
+
+static struct app_ota_stats stats;
+static int64_t download_start;
+static int64_t backoff_start = -1;
+static uint64_t backoff_ms;
+static struct k_spinlock lock;
+
+/* Block request tracking of the running download */
+static uint32_t next_block;
+static uint32_t retx_block;
+static uint32_t retx_count;
+static uint64_t flash_sum_us;
+static uint32_t flash_max_us;
+static uint32_t flash_writes;
+static uint32_t flash_bytes;
+
+static uint32_t downloaded_image_size(void)
+{
+#ifdef CONFIG_BOOTLOADER_MCUBOOT
+	struct mcuboot_img_header header;
+
+	if (boot_read_bank_header(FIXED_PARTITION_ID(slot1_partition), &header, sizeof(header)) ==
+	    0) {
+		return header.h.v1.image_size;
+	}
+#endif
+
+	return 0;
+}
+
+static bool ota_is_component_request(struct coap_packet *pkt)
+{
+	struct coap_option path[2];
+
+	if ((coap_header_get_code(pkt) != COAP_METHOD_GET) ||
+	    (coap_find_options(pkt, COAP_OPTION_URI_PATH, path, ARRAY_SIZE(path)) !=
+	     ARRAY_SIZE(path))) {
+		return false;
+	}
+
+	return (path[0].len == strlen(OTA_COMPONENT_PATH_0)) &&
+	       (memcmp(path[0].value, OTA_COMPONENT_PATH_0, path[0].len) == 0) &&
+	       (path[1].len == strlen(OTA_COMPONENT_PATH_1)) &&
+	       (memcmp(path[1].value, OTA_COMPONENT_PATH_1, path[1].len) == 0);
+}
+
+void app_ota_coap_sent(const void *buf, size_t len)
+{
+	struct coap_packet pkt;
+
+	if (!stats.throttled ||
+	    (coap_packet_parse(&pkt, (uint8_t *)buf, len, NULL, 0) != 0) ||
+	    !ota_is_component_request(&pkt)) {
+		return;
+	}
+
+	int block2 = coap_get_option_int(&pkt, COAP_OPTION_BLOCK2);
+	uint32_t block = (block2 > 0) ? GET_BLOCK_NUM(block2) : 0;
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	if (block >= next_block) {
+		next_block = block + 1;
+	} else {
+		/* A block requested again, by CoAP retransmission or a new request */
+		if (block != retx_block) {
+			retx_block = block;
+			retx_count = 0;
+		}
+		retx_count++;
+		stats.last_block_retransmits++;
+		stats.last_max_block_retransmits = MAX(stats.last_max_block_retransmits,
+						       retx_count);
+	}
+
+	k_spin_unlock(&lock, key);
+}
+
+#ifdef CONFIG_STREAM_FLASH
+/* Firmware blocks are written through stream_flash, erasing progressively */
+int __real_stream_flash_buffered_write(struct stream_flash_ctx *ctx, const uint8_t *data,
+				       size_t len, bool flush);
+
+int __wrap_stream_flash_buffered_write(struct stream_flash_ctx *ctx, const uint8_t *data,
+				       size_t len, bool flush)
+{
+	int64_t start = k_uptime_ticks();
+	int ret = __real_stream_flash_buffered_write(ctx, data, len, flush);
+	uint32_t duration_us = k_ticks_to_us_ceil32(k_uptime_ticks() - start);
+
+	if (stats.throttled) {
+		k_spinlock_key_t key = k_spin_lock(&lock);
+
+		flash_writes++;
+		flash_bytes += len;
+		flash_sum_us += duration_us;
+		flash_max_us = MAX(flash_max_us, duration_us);
+		k_spin_unlock(&lock, key);
+	}
+
+	return ret;
+}
+#endif /* CONFIG_STREAM_FLASH */
+
+static void download_reset(int64_t now)
+{
+	download_start = now;
+	backoff_start = -1;
+	backoff_ms = 0;
+	next_block = 0;
+	retx_block = UINT32_MAX;
+	retx_count = 0;
+	flash_sum_us = 0;
+	flash_max_us = 0;
+	flash_writes = 0;
+	flash_bytes = 0;
+	stats.last_retries = 0;
+	stats.last_block_retransmits = 0;
+	stats.last_max_block_retransmits = 0;
+}
+
+static void throttle(bool enable)
+{
+	LOG_INF("%s reduced traffic mode for firmware download", enable ? "Entering" : "Leaving");
+
+	/* Sensor readings go to the backlog instead, see app_ota_is_downloading() */
+	app_uplink_hold(APP_UPLINK_BULK, enable);
+	app_uplink_log_limit(CONFIG_APP_OTA_THROTTLE_LOG_LEVEL, enable);
+}
+
+static void on_ota_state_change(enum golioth_ota_state state, enum golioth_ota_reason reason,
+				void *user_arg)
+{
+	int64_t now = k_uptime_get();
+	bool start = false;
+	bool stop = false;
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	if (reason == GOLIOTH_OTA_REASON_AWAIT_RETRY) {
+		/* Stay in reduced traffic mode while the download is retried */
+		stats.retries++;
+		stats.last_retries++;
+		if (backoff_start < 0) {
+			backoff_start = now;
+		}
+		k_spin_unlock(&lock, key);
+		return;
+	}
+
+	if (backoff_start >= 0) {
+		backoff_ms += now - backoff_start;
+		backoff_start = -1;
+	}
+
+	switch (state) {
+	case GOLIOTH_OTA_STATE_DOWNLOADING:
+		if (!stats.throttled) {
+			download_reset(now);
+			stats.throttled = true;
+			stats.downloads++;
+			start = true;
+		}
+		break;
+	case GOLIOTH_OTA_STATE_DOWNLOADED:
+		if (stats.throttled) {
+			stats.last_duration_ms = (uint32_t)(now - download_start);
+			stats.last_backoff_ms = (uint32_t)backoff_ms;
+			stats.last_blocks = flash_writes;
+			stats.last_flash_avg_us = flash_writes ? (flash_sum_us / flash_writes) : 0;
+			stats.last_flash_max_us = flash_max_us;
+		}
+		break;
+	case GOLIOTH_OTA_STATE_UPDATING:
+		/* The device reboots into the new image, stay quiet */
+		break;
+	default:
+		if (stats.throttled) {
+			stats.throttled = false;
+			if (reason != GOLIOTH_OTA_REASON_READY) {
+				stats.failures++;
+			}
+			stop = true;
+		}
+		break;
+	}
+
+	k_spin_unlock(&lock, key);
+
+	if (state == GOLIOTH_OTA_STATE_DOWNLOADED) {
+		uint32_t image_bytes = downloaded_image_size();
+
+		key = k_spin_lock(&lock);
+
+		/* Without an MCUboot header (e.g. native_sim), count what was written */
+		if (image_bytes == 0) {
+			image_bytes = flash_bytes;
+		}
+
+		/* Waiting to retry is not transfer time */
+		uint32_t active_ms = stats.last_duration_ms - stats.last_backoff_ms;
+
+		stats.last_image_bytes = image_bytes;
+		stats.last_throughput_bps =
+			active_ms ? (uint32_t)((uint64_t)image_bytes * MSEC_PER_SEC / active_ms)
+				  : 0;
+		k_spin_unlock(&lock, key);
+
+		app_acct_rx(APP_ACCT_OTA, DIV_ROUND_UP(image_bytes, GOLIOTH_OTA_BLOCKSIZE),
+			    image_bytes);
+
+		if (image_bytes) {
+			LOG_INF("Firmware download took %u ms (%u ms back-off): %u bytes, "
+				"%u B/s, %u retries",
+				stats.last_duration_ms, stats.last_backoff_ms, image_bytes,
+				stats.last_throughput_bps, stats.last_retries);
+		} else {
+			LOG_INF("Firmware download took %u ms (%u ms back-off), image size "
+				"unknown, %u retries",
+				stats.last_duration_ms, stats.last_backoff_ms, stats.last_retries);
+		}
+		LOG_INF("%u blocks, %u retransmits (max %u per block), flash %u us avg %u us max",
+			stats.last_blocks, stats.last_block_retransmits,
+			stats.last_max_block_retransmits, stats.last_flash_avg_us,
+			stats.last_flash_max_us);
+	}
+
+	if (start || stop) {
+		throttle(start);
+	}
+}
+
+void app_ota_init(void)
+{
+	golioth_fw_update_register_state_change_callback(on_ota_state_change, NULL);
+}
+
+bool app_ota_is_downloading(void)
+{
+	return stats.throttled;
+}
+
+void app_ota_stats_get(struct app_ota_stats *ota_stats)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	*ota_stats = stats;
+
+	k_spin_unlock(&lock, key);
+}
@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2026 Golioth, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/** Reduce competing traffic while a firmware update downloads, and record
+ * download metrics.
+ *
+ * When the Golioth firmware update reports that a download has started, bulk
+ * uplink traffic is held and the Golioth log backend threshold is raised to
+ * `CONFIG_APP_OTA_THROTTLE_LOG_LEVEL`. Sensor readings are buffered in the
+ * offline backlog (see app_backlog.h) meanwhile, so they are not dropped from
+ * the held bulk queue. Normal operation resumes when the update returns to
+ * idle, whether it failed or a retry gave up.
+ *
+ * Download duration, retries, image size and throughput are available through
+ * `app_ota_stats_get()` and the `get_ota_stats` RPC. The throughput excludes
+ * the back-off before retries. The image size is read from the MCUboot header
+ * when available, and counted from the bytes written to flash otherwise.
+ * Block requests are read from the client's CoAP traffic (see app_conn.h) to
+ * count blocks requested more than once, and the flash write of every block,
+ * including progressive erase, is timed by wrapping
+ * `stream_flash_buffered_write()` at link time.
+ */
+
+#ifndef __APP_OTA_H__
+#define __APP_OTA_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+struct app_ota_stats {
+	bool throttled;
+	uint32_t downloads;
+	/* Retries of all downloads */
+	uint32_t retries;
+	uint32_t failures;
+	uint32_t last_duration_ms;
+	uint32_t last_retries;
+	uint32_t last_image_bytes;
+	/* 0 when the image size is unknown */
+	uint32_t last_throughput_bps;
+	/* Time spent waiting to retry, excluded from the throughput */
+	uint32_t last_backoff_ms;
+	uint32_t last_blocks;
+	/* Block requests sent again, in total and for the worst block */
+	uint32_t last_block_retransmits;
+	uint32_t last_max_block_retransmits;
+	/* Flash write time per block, including progressive erase */
+	uint32_t last_flash_avg_us;
+	uint32_t last_flash_max_us;
+};
+
+void app_ota_init(void);
+void app_ota_stats_get(struct app_ota_stats *stats);
+
+/** Whether a firmware image is downloading, with bulk traffic held */
+bool app_ota_is_downloading(void);
+
+/** Inspect a CoAP message the client sent, called from the client thread */
+void app_ota_coap_sent(const void *buf, size_t len);
+
+#endif /* __APP_OTA_H__ */
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2026 Golioth, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/init.h>
+#include <zephyr/kernel.h>
+#include <zephyr/spinlock.h>
+#include <zephyr/sys/printk.h>
+
+#include "app_perf.h"
+
+struct perf_stats {
+	uint32_t count;
+	uint32_t cycles_min;
+	uint32_t cycles_max;
+	uint64_t cycles_sum;
+	uint64_t bytes;
+};
+
+static const char *const probe_names[APP_PERF_PROBE_COUNT] = {
+	[APP_PERF_SENSOR_ENCODE] = "sensor_encode",
+	[APP_PERF_STATE_PARSE] = "state_parse",
+	[APP_PERF_STATE_FORMAT] = "state_format",
+	[APP_PERF_RPC_DECODE] = "rpc_decode",
+	[APP_PERF_CAPTURE_DECODE] = "capture_decode",
+};
+
+static struct perf_stats stats[APP_PERF_PROBE_COUNT];
+static struct k_spinlock lock;
+
+void app_perf_record(enum app_perf_probe probe, uint32_t cycles, size_t bytes)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	struct perf_stats *s = &stats[probe];
+
+	if ((s->count == 0) || (cycles < s->cycles_min)) {
+		s->cycles_min = cycles;
+	}
+	s->cycles_max = MAX(s->cycles_max, cycles);
+	s->cycles_sum += cycles;
+	s->bytes += bytes;
+	s->count++;
+
+	k_spin_unlock(&lock, key);
+}
+
+void app_perf_report(void)
+{
+	for (int i = 0; i < APP_PERF_PROBE_COUNT; i++) {
+		k_spinlock_key_t key = k_spin_lock(&lock);
+		struct perf_stats s = stats[i];
+
+		k_spin_unlock(&lock, key);
+
+		if (s.count == 0) {
+			continue;
+		}
+
+		/* Printed directly so the output is not wrapped by the log formatter */
+		printk("{\"perf\":\"%s\",\"count\":%u,\"cycles_min\":%u,\"cycles_avg\":%u,"
+		       "\"cycles_max\":%u,\"bytes\":%u,\"cycles_per_sec\":%u}\n",
+		       probe_names[i], s.count, s.cycles_min, (uint32_t)(s.cycles_sum / s.count),
+		       s.cycles_max, (uint32_t)s.bytes, sys_clock_hw_cycles_per_sec());
+	}
+}
+
+static void perf_report_work_handler(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(perf_report_work, perf_report_work_handler);
+
+static void perf_report_work_handler(struct k_work *work)
+{
+	app_perf_report();
+	k_work_schedule(&perf_report_work, K_SECONDS(CONFIG_APP_PERF_REPORT_INTERVAL_S));
+}
+
+static int app_perf_init(void)
+{
+	k_work_schedule(&perf_report_work, K_SECONDS(CONFIG_APP_PERF_REPORT_INTERVAL_S));
+
+	return 0;
+}
+
+SYS_INIT(app_perf_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
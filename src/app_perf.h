@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2026 Golioth, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/** Lightweight probes for the application's encode and parse hot paths.
+ *
+ * Wrap a code section in `APP_PERF_START()` / `APP_PERF_STOP()` to record the
+ * cycles it took and the number of bytes it produced or consumed. With
+ * `CONFIG_APP_PERF` enabled, a JSON summary per probe is printed every
+ * `CONFIG_APP_PERF_REPORT_INTERVAL_S` seconds:
+ *
+ *   {"perf":"sensor_encode","count":12,"cycles_min":410,"cycles_avg":433,
+ *    "cycles_max":520,"bytes":120,"cycles_per_sec":64000000}
+ *
+ * With `CONFIG_APP_PERF` disabled the probes compile to nothing.
+ */
+
+#ifndef __APP_PERF_H__
+#define __APP_PERF_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <zephyr/kernel.h>
+
+enum app_perf_probe {
+	APP_PERF_SENSOR_ENCODE,
+	APP_PERF_STATE_PARSE,
+	APP_PERF_STATE_FORMAT,
+	APP_PERF_RPC_DECODE,
+	APP_PERF_CAPTURE_DECODE,
+	APP_PERF_PROBE_COUNT
+};
+
+#ifdef CONFIG_APP_PERF
+
+void app_perf_record(enum app_perf_probe probe, uint32_t cycles, size_t bytes);
+void app_perf_report(void);
+
+#define APP_PERF_START(name) uint32_t _perf_##name = k_cycle_get_32()
+#define APP_PERF_STOP(name, probe, bytes)                                                          \
+	app_perf_record(probe, k_cycle_get_32() - _perf_##name, bytes)
+
+#else
+
+static inline void app_perf_report(void)
+{
+}
+
+#define APP_PERF_START(name)
+#define APP_PERF_STOP(name, probe, bytes)
+
+#endif /* CONFIG_APP_PERF */
+
+#endif /* __APP_PERF_H__ */
@@ -9,14 +9,21 @@ LOG_MODULE_REGISTER(app_rpc, LOG_LEVEL_DBG);
 
 #include <golioth/client.h>
 #include <golioth/rpc.h>
-#include <zephyr/logging/log_ctrl.h>
 #include <zephyr/sys/reboot.h>
 
 #ifdef CONFIG_NETWORK_INFO
 #include <network_info.h>
 #endif
 
+#include "app_acct.h"
+#include "app_benchmark.h"
+#include "app_bus.h"
+#include "app_capture.h"
+#include "app_codec.h"
+#include "app_conn.h"
+#include "app_ota.h"
 #include "app_rpc.h"
+#include "app_uplink.h"
 
 static void reboot_work_handler(struct k_work *work)
 {
@@ -47,46 +54,267 @@ static enum golioth_rpc_status on_set_log_level(zcbor_state_t *request_params_ar
 						zcbor_state_t *response_detail_map,
 						void *callback_arg)
 {
-	double param_0;
 	uint8_t log_level;
 	bool ok;
+	int err;
 
 	LOG_WRN("on_set_log_level");
 
-	ok = zcbor_float_decode(request_params_array, &param_0);
-	if (!ok) {
+	err = app_codec_log_level_decode(request_params_array, &log_level);
+	if (err == -EBADMSG) {
 		LOG_ERR("Failed to decode array item");
 		return GOLIOTH_RPC_INVALID_ARGUMENT;
+	} else if (err) {
+		LOG_ERR("Requested log level is out of bounds");
+		return GOLIOTH_RPC_INVALID_ARGUMENT;
+	}
+
+	/* Through the uplink scheduler, so a pending log level cap does not undo it */
+	int source_id = app_uplink_log_level_set(log_level);
+
+	if (source_id < 0) {
+		LOG_ERR("Failed to set log levels: %d", source_id);
+		return GOLIOTH_RPC_UNIMPLEMENTED;
+	}
+
+	LOG_WRN("Log levels for %d modules set to: %d", source_id, log_level);
+
+	ok = zcbor_tstr_put_lit(response_detail_map, "log_modules") &&
+	     zcbor_float64_put(response_detail_map, (double)source_id);
+
+	return GOLIOTH_RPC_OK;
+}
+
+static enum golioth_rpc_status on_get_uplink_stats(zcbor_state_t *request_params_array,
+						   zcbor_state_t *response_detail_map,
+						   void *callback_arg)
+{
+	struct app_uplink_stats stats;
+	bool ok = true;
+
+	for (int i = 0; i < APP_UPLINK_CLASS_COUNT; i++) {
+		const char *name = app_uplink_class_name(i);
+
+		app_uplink_stats_get(i, &stats);
+
+		ok = ok && zcbor_tstr_put_term(response_detail_map, name, SIZE_MAX) &&
+		     zcbor_map_start_encode(response_detail_map, 6) &&
+		     zcbor_tstr_put_lit(response_detail_map, "queued") &&
+		     zcbor_uint32_put(response_detail_map, stats.queued) &&
+		     zcbor_tstr_put_lit(response_detail_map, "sent") &&
+		     zcbor_uint32_put(response_detail_map, stats.sent) &&
+		     zcbor_tstr_put_lit(response_detail_map, "dropped") &&
+		     zcbor_uint32_put(response_detail_map, stats.dropped) &&
+		     zcbor_tstr_put_lit(response_detail_map, "failed") &&
+		     zcbor_uint32_put(response_detail_map, stats.failed) &&
+		     zcbor_tstr_put_lit(response_detail_map, "latency_avg_ms") &&
+		     zcbor_uint32_put(response_detail_map, stats.latency_avg_ms) &&
+		     zcbor_tstr_put_lit(response_detail_map, "latency_max_ms") &&
+		     zcbor_uint32_put(response_detail_map, stats.latency_max_ms) &&
+		     zcbor_map_end_encode(response_detail_map, 6);
+	}
+
+	if (!ok) {
+		LOG_ERR("Failed to encode uplink stats");
+		return GOLIOTH_RPC_RESOURCE_EXHAUSTED;
+	}
+
+	return GOLIOTH_RPC_OK;
+}
+
+static enum golioth_rpc_status on_get_bus_stats(zcbor_state_t *request_params_array,
+						zcbor_state_t *response_detail_map,
+						void *callback_arg)
+{
+	struct app_bus_stats stats;
+	bool ok = true;
+
+	for (int i = 0; i < APP_BUS_CHANNEL_COUNT; i++) {
+		const char *name = app_bus_channel_name(i);
+
+		app_bus_stats_get(i, &stats);
+
+		ok = ok && zcbor_tstr_put_term(response_detail_map, name, SIZE_MAX) &&
+		     zcbor_map_start_encode(response_detail_map, 3) &&
+		     zcbor_tstr_put_lit(response_detail_map, "published") &&
+		     zcbor_uint32_put(response_detail_map, stats.published) &&
+		     zcbor_tstr_put_lit(response_detail_map, "avg_period_ms") &&
+		     zcbor_uint32_put(response_detail_map, stats.avg_period_ms) &&
+		     zcbor_tstr_put_lit(response_detail_map, "last_age_ms") &&
+		     zcbor_uint32_put(response_detail_map, stats.last_age_ms) &&
+		     zcbor_map_end_encode(response_detail_map, 3);
+	}
+
+	if (!ok) {
+		LOG_ERR("Failed to encode bus stats");
+		return GOLIOTH_RPC_RESOURCE_EXHAUSTED;
+	}
+
+	return GOLIOTH_RPC_OK;
+}
+
+static enum golioth_rpc_status on_get_connection_stats(zcbor_state_t *request_params_array,
+						       zcbor_state_t *response_detail_map,
+						       void *callback_arg)
+{
+	struct app_conn_stats stats;
+	bool ok;
+
+	app_conn_stats_get(&stats);
+
+	ok = zcbor_tstr_put_lit(response_detail_map, "connects") &&
+	     zcbor_uint32_put(response_detail_map, stats.connects) &&
+	     zcbor_tstr_put_lit(response_detail_map, "disconnects") &&
+	     zcbor_uint32_put(response_detail_map, stats.disconnects) &&
+	     zcbor_tstr_put_lit(response_detail_map, "full_handshakes") &&
+	     zcbor_uint32_put(response_detail_map, stats.full_handshakes) &&
+	     zcbor_tstr_put_lit(response_detail_map, "full_avg_ms") &&
+	     zcbor_uint32_put(response_detail_map, stats.full_avg_ms) &&
+	     zcbor_tstr_put_lit(response_detail_map, "full_max_ms") &&
+	     zcbor_uint32_put(response_detail_map, stats.full_max_ms) &&
+	     zcbor_tstr_put_lit(response_detail_map, "abbreviated_handshakes") &&
+	     zcbor_uint32_put(response_detail_map, stats.abbreviated_handshakes) &&
+	     zcbor_tstr_put_lit(response_detail_map, "abbreviated_avg_ms") &&
+	     zcbor_uint32_put(response_detail_map, stats.abbreviated_avg_ms) &&
+	     zcbor_tstr_put_lit(response_detail_map, "abbreviated_max_ms") &&
+	     zcbor_uint32_put(response_detail_map, stats.abbreviated_max_ms) &&
+	     zcbor_tstr_put_lit(response_detail_map, "unclassified_handshakes") &&
+	     zcbor_uint32_put(response_detail_map, stats.unclassified_handshakes) &&
+	     zcbor_tstr_put_lit(response_detail_map, "failed_handshakes") &&
+	     zcbor_uint32_put(response_detail_map, stats.failed_handshakes) &&
+	     zcbor_tstr_put_lit(response_detail_map, "last_handshake_ms") &&
+	     zcbor_uint32_put(response_detail_map, stats.last_handshake_ms);
+
+	if (!ok) {
+		LOG_ERR("Failed to encode connection stats");
+		return GOLIOTH_RPC_RESOURCE_EXHAUSTED;
+	}
+
+	return GOLIOTH_RPC_OK;
+}
+
+static enum golioth_rpc_status on_get_ota_stats(zcbor_state_t *request_params_array,
+						zcbor_state_t *response_detail_map,
+						void *callback_arg)
+{
+	struct app_ota_stats stats;
+	bool ok;
+
+	app_ota_stats_get(&stats);
+
+	ok = zcbor_tstr_put_lit(response_detail_map, "throttled") &&
+	     zcbor_bool_put(response_detail_map, stats.throttled) &&
+	     zcbor_tstr_put_lit(response_detail_map, "downloads") &&
+	     zcbor_uint32_put(response_detail_map, stats.downloads) &&
+	     zcbor_tstr_put_lit(response_detail_map, "retries") &&
+	     zcbor_uint32_put(response_detail_map, stats.retries) &&
+	     zcbor_tstr_put_lit(response_detail_map, "failures") &&
+	     zcbor_uint32_put(response_detail_map, stats.failures) &&
+	     zcbor_tstr_put_lit(response_detail_map, "last_duration_ms") &&
+	     zcbor_uint32_put(response_detail_map, stats.last_duration_ms) &&
+	     zcbor_tstr_put_lit(response_detail_map, "last_retries") &&
+	     zcbor_uint32_put(response_detail_map, stats.last_retries) &&
+	     zcbor_tstr_put_lit(response_detail_map, "last_image_bytes") &&
+	     zcbor_uint32_put(response_detail_map, stats.last_image_bytes) &&
+	     zcbor_tstr_put_lit(response_detail_map, "last_throughput_bps") &&
+	     zcbor_uint32_put(response_detail_map, stats.last_throughput_bps) &&
+	     zcbor_tstr_put_lit(response_detail_map, "last_backoff_ms") &&
+	     zcbor_uint32_put(response_detail_map, stats.last_backoff_ms) &&
+	     zcbor_tstr_put_lit(response_detail_map, "last_blocks") &&
+	     zcbor_uint32_put(response_detail_map, stats.last_blocks) &&
+	     zcbor_tstr_put_lit(response_detail_map, "last_block_retransmits") &&
+	     zcbor_uint32_put(response_detail_map, stats.last_block_retransmits) &&
+	     zcbor_tstr_put_lit(response_detail_map, "last_max_block_retransmits") &&
+	     zcbor_uint32_put(response_detail_map, stats.last_max_block_retransmits) &&
+	     zcbor_tstr_put_lit(response_detail_map, "last_flash_avg_us") &&
+	     zcbor_uint32_put(response_detail_map, stats.last_flash_avg_us) &&
+	     zcbor_tstr_put_lit(response_detail_map, "last_flash_max_us") &&
+	     zcbor_uint32_put(response_detail_map, stats.last_flash_max_us);
+
+	if (!ok) {
+		LOG_ERR("Failed to encode OTA stats");
+		return GOLIOTH_RPC_RESOURCE_EXHAUSTED;
 	}
 
-	log_level = (uint8_t)param_0;
+	return GOLIOTH_RPC_OK;
+}
 
-	if ((log_level < 0) || (log_level > LOG_LEVEL_DBG)) {
+#ifdef CONFIG_APP_CAPTURE
+static enum golioth_rpc_status on_start_capture(zcbor_state_t *request_params_array,
+						zcbor_state_t *response_detail_map,
+						void *callback_arg)
+{
+	uint32_t duration_s;
+	uint32_t rate_hz;
+	uint32_t id;
+	int err;
 
-		LOG_ERR("Requested log level is out of bounds: %d", log_level);
+	err = app_codec_capture_decode(request_params_array, &duration_s, &rate_hz);
+	if (err == -EBADMSG) {
+		LOG_ERR("Failed to decode capture duration and rate");
+		return GOLIOTH_RPC_INVALID_ARGUMENT;
+	} else if (err) {
+		LOG_ERR("Capture duration or rate out of bounds");
 		return GOLIOTH_RPC_INVALID_ARGUMENT;
 	}
 
-	int source_id = 0;
-	char *source_name;
+	err = app_capture_start(duration_s, rate_hz, &id);
+	if (err == -EBUSY) {
+		return GOLIOTH_RPC_UNAVAILABLE;
+	} else if (err == -ERANGE) {
+		LOG_ERR("Capture rate of %u Hz not possible with %u ticks/s", rate_hz,
+			CONFIG_SYS_CLOCK_TICKS_PER_SEC);
+		return GOLIOTH_RPC_INVALID_ARGUMENT;
+	} else if (err) {
+		LOG_ERR("Capture of %us at %u Hz does not fit the capture buffer", duration_s,
+			rate_hz);
+		return GOLIOTH_RPC_INVALID_ARGUMENT;
+	}
 
-	while (1) {
-		source_name = (char *)log_source_name_get(0, source_id);
-		if (source_name == NULL) {
-			break;
-		}
+	bool ok = zcbor_tstr_put_lit(response_detail_map, "id") &&
+		  zcbor_uint32_put(response_detail_map, id);
 
-		log_filter_set(NULL, 0, source_id, log_level);
-		++source_id;
+	if (!ok) {
+		LOG_ERR("Failed to encode capture id");
+		return GOLIOTH_RPC_RESOURCE_EXHAUSTED;
 	}
 
-	LOG_WRN("Log levels for %d modules set to: %d", source_id, log_level);
+	return GOLIOTH_RPC_OK;
+}
 
-	ok = zcbor_tstr_put_lit(response_detail_map, "log_modules") &&
-	     zcbor_float64_put(response_detail_map, (double)source_id);
+static enum golioth_rpc_status on_get_capture_status(zcbor_state_t *request_params_array,
+						     zcbor_state_t *response_detail_map,
+						     void *callback_arg)
+{
+	struct app_capture_status status;
+	bool ok;
+
+	app_capture_status_get(&status);
+
+	ok = zcbor_tstr_put_lit(response_detail_map, "state") &&
+	     zcbor_tstr_put_term(response_detail_map, app_capture_state_name(status.state),
+				 SIZE_MAX) &&
+	     zcbor_tstr_put_lit(response_detail_map, "id") &&
+	     zcbor_uint32_put(response_detail_map, status.id) &&
+	     zcbor_tstr_put_lit(response_detail_map, "samples") &&
+	     zcbor_uint32_put(response_detail_map, status.samples) &&
+	     zcbor_tstr_put_lit(response_detail_map, "samples_total") &&
+	     zcbor_uint32_put(response_detail_map, status.samples_total) &&
+	     zcbor_tstr_put_lit(response_detail_map, "chunks_sent") &&
+	     zcbor_uint32_put(response_detail_map, status.chunks_sent) &&
+	     zcbor_tstr_put_lit(response_detail_map, "chunks_total") &&
+	     zcbor_uint32_put(response_detail_map, status.chunks_total) &&
+	     zcbor_tstr_put_lit(response_detail_map, "aborted") &&
+	     zcbor_bool_put(response_detail_map, status.aborted);
+
+	if (!ok) {
+		LOG_ERR("Failed to encode capture status");
+		return GOLIOTH_RPC_RESOURCE_EXHAUSTED;
+	}
 
 	return GOLIOTH_RPC_OK;
 }
+#endif /* CONFIG_APP_CAPTURE */
 
 static enum golioth_rpc_status on_reboot(zcbor_state_t *request_params_array,
 					 zcbor_state_t *response_detail_map, void *callback_arg)
@@ -97,10 +325,94 @@ static enum golioth_rpc_status on_reboot(zcbor_state_t *request_params_array,
 	return GOLIOTH_RPC_OK;
 }
 
-static void rpc_log_if_register_failure(int err)
+#ifdef CONFIG_APP_BENCHMARK
+static enum golioth_rpc_status on_run_benchmark(zcbor_state_t *request_params_array,
+						zcbor_state_t *response_detail_map,
+						void *callback_arg)
 {
+	struct golioth_client *client = callback_arg;
+	uint32_t id;
+	int err;
+
+	err = app_benchmark_start(client, &id);
+	if (err == -EBUSY) {
+		return GOLIOTH_RPC_UNAVAILABLE;
+	}
+
+	bool ok = zcbor_tstr_put_lit(response_detail_map, "id") &&
+		  zcbor_uint32_put(response_detail_map, id);
+
+	if (!ok) {
+		LOG_ERR("Failed to encode benchmark id");
+		return GOLIOTH_RPC_RESOURCE_EXHAUSTED;
+	}
+
+	return GOLIOTH_RPC_OK;
+}
+
+static enum golioth_rpc_status on_get_benchmark_results(zcbor_state_t *request_params_array,
+							zcbor_state_t *response_detail_map,
+							void *callback_arg)
+{
+	if (!app_benchmark_results_encode(response_detail_map)) {
+		LOG_ERR("Failed to encode benchmark results");
+		return GOLIOTH_RPC_RESOURCE_EXHAUSTED;
+	}
+
+	return GOLIOTH_RPC_OK;
+}
+#endif /* CONFIG_APP_BENCHMARK */
+
+#ifdef CONFIG_APP_ACCT
+struct rpc_accounted_handler {
+	golioth_rpc_cb_fn fn;
+	void *arg;
+};
+
+static struct rpc_accounted_handler accounted_handlers[CONFIG_APP_ACCT_RPC_MAX];
+static size_t accounted_handlers_len;
+
+/* Counts request parameters and response details of every RPC call */
+static enum golioth_rpc_status rpc_accounted(zcbor_state_t *request_params_array,
+					     zcbor_state_t *response_detail_map, void *callback_arg)
+{
+	const struct rpc_accounted_handler *handler = callback_arg;
+	const uint8_t *response_start = response_detail_map->payload;
+	enum golioth_rpc_status status;
+
+	app_acct_rx(APP_ACCT_RPC, 1,
+		    request_params_array->payload_end - request_params_array->payload);
+
+	status = handler->fn(request_params_array, response_detail_map, handler->arg);
+
+	app_acct_tx(APP_ACCT_RPC, 1, response_detail_map->payload - response_start);
+
+	return status;
+}
+#endif /* CONFIG_APP_ACCT */
+
+static void rpc_register(struct golioth_rpc *rpc, const char *method, golioth_rpc_cb_fn fn,
+			 void *arg)
+{
+	int err;
+
+#ifdef CONFIG_APP_ACCT
+	if (accounted_handlers_len < ARRAY_SIZE(accounted_handlers)) {
+		struct rpc_accounted_handler *handler =
+			&accounted_handlers[accounted_handlers_len++];
+
+		handler->fn = fn;
+		handler->arg = arg;
+		fn = rpc_accounted;
+		arg = handler;
+	} else {
+		LOG_WRN("RPC %s is not accounted, raise CONFIG_APP_ACCT_RPC_MAX", method);
+	}
+#endif
+
+	err = golioth_rpc_register(rpc, method, fn, arg);
 	if (err) {
-		LOG_ERR("Failed to register RPC: %d", err);
+		LOG_ERR("Failed to register RPC %s: %d", method, err);
 	}
 }
 
@@ -108,14 +420,21 @@ void app_rpc_register(struct golioth_client *client)
 {
 	struct golioth_rpc *rpc = golioth_rpc_init(client);
 
-	int err;
+	rpc_register(rpc, "get_network_info", on_get_network_info, NULL);
+	rpc_register(rpc, "reboot", on_reboot, NULL);
+	rpc_register(rpc, "set_log_level", on_set_log_level, NULL);
+	rpc_register(rpc, "get_uplink_stats", on_get_uplink_stats, NULL);
+	rpc_register(rpc, "get_bus_stats", on_get_bus_stats, NULL);
+	rpc_register(rpc, "get_connection_stats", on_get_connection_stats, NULL);
+	rpc_register(rpc, "get_ota_stats", on_get_ota_stats, NULL);
 
-	err = golioth_rpc_register(rpc, "get_network_info", on_get_network_info, NULL);
-	rpc_log_if_register_failure(err);
-
-	err = golioth_rpc_register(rpc, "reboot", on_reboot, NULL);
-	rpc_log_if_register_failure(err);
+#ifdef CONFIG_APP_CAPTURE
+	rpc_register(rpc, "start_capture", on_start_capture, NULL);
+	rpc_register(rpc, "get_capture_status", on_get_capture_status, NULL);
+#endif
 
-	err = golioth_rpc_register(rpc, "set_log_level", on_set_log_level, NULL);
-	rpc_log_if_register_failure(err);
+#ifdef CONFIG_APP_BENCHMARK
+	rpc_register(rpc, "run_benchmark", on_run_benchmark, client);
+	rpc_register(rpc, "get_benchmark_results", on_get_benchmark_results, NULL);
+#endif
 }
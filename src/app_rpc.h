@@ -13,6 +13,22 @@
  * - `reboot`: reboot the device (no arguments)
  * - `set_log_level`: adjust the logging level for all registered modules (valid
  *   argument values: 0..4)
+ * - `get_uplink_stats`: return per traffic class counters and latency of the
+ *   uplink scheduler (no arguments)
+ * - `get_bus_stats`: return per channel publication counts and rates of the
+ *   internal event bus (no arguments)
+ * - `get_connection_stats`: return connect counts and full vs abbreviated DTLS
+ *   handshake times (no arguments)
+ * - `get_ota_stats`: return firmware download duration, size, throughput and
+ *   retry counts (no arguments)
+ * - `start_capture`: sample at a high rate for a short time and upload the
+ *   capture afterwards (arguments: duration in seconds, rate in Hz)
+ * - `get_capture_status`: return the state and progress of the last capture
+ *   (no arguments)
+ * - `run_benchmark`: run the self-benchmark suite in the background (no
+ *   arguments)
+ * - `get_benchmark_results`: return the results of the last benchmark run (no
+ *   arguments)
  *
  * https://docs.golioth.io/firmware/zephyr-device-sdk/remote-procedure-call
  */
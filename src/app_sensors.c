@@ -12,13 +12,15 @@ LOG_MODULE_REGISTER(app_sensors, LOG_LEVEL_DBG);
 #include <zcbor_encode.h>
 #include <zephyr/drivers/gpio.h>
 #include <zephyr/kernel.h>
+#include <zephyr/zbus/zbus.h>
 
+#include "app_acct.h"
+#include "app_bus.h"
+#include "app_codec.h"
+#include "app_ota.h"
 #include "app_sensors.h"
+#include "app_uplink.h"
 
-#ifdef CONFIG_LIB_OSTENTUS
-#include <libostentus.h>
-static const struct device *o_dev = DEVICE_DT_GET_ANY(golioth_ostentus);
-#endif
 #ifdef CONFIG_ALUDEL_BATTERY_MONITOR
 #include <battery_monitor.h>
 #endif
@@ -26,89 +28,148 @@ static const struct device *o_dev = DEVICE_DT_GET_ANY(golioth_ostentus);
 static struct golioth_client *client;
 /* Add Sensor structs here */
 
-/* Callback for LightDB Stream */
-static void async_error_handler(struct golioth_client *client, enum golioth_status status,
-				const struct golioth_coap_rsp_code *coap_rsp_code, const char *path,
-				void *arg)
-{
-	if (status != GOLIOTH_OK) {
-		LOG_ERR("Async task failed: %d", status);
-		return;
-	}
-}
+/* For this demo, we just send counter data to Golioth */
+static uint16_t counter;
 
 /* This will be called by the main() loop */
 /* Do all of your work here! */
-void app_sensors_read_and_stream(void)
+void app_sensors_read_and_publish(void)
 {
 	int err;
 
 	/* Golioth custom hardware for demos */
-	IF_ENABLED(CONFIG_ALUDEL_BATTERY_MONITOR, (
-		read_and_report_battery(client);
-		IF_ENABLED(CONFIG_LIB_OSTENTUS, (
-			ostentus_slide_set(o_dev,
-					   BATTERY_V,
-					   get_batt_v_str(),
-					   strlen(get_batt_v_str()));
-			ostentus_slide_set(o_dev,
-					   BATTERY_PCT,
-					   get_batt_pct_str(),
-					   strlen(get_batt_pct_str()));
-		));
-	));
-
-	/* Send sensor data to Golioth */
-	/* For this demo, we just send counter data to Golioth */
-	static uint16_t counter;
-
-	/* Only stream sensor data if connected */
-	if (golioth_client_is_connected(client)) {
-		/* Encode sensor data using CBOR serialization */
-		uint8_t cbor_buf[13];
-
-		ZCBOR_STATE_E(zse, 1, cbor_buf, sizeof(cbor_buf), 1);
-
-		bool ok = zcbor_map_start_encode(zse, 1) && zcbor_tstr_put_lit(zse, "counter") &&
-			  zcbor_uint32_put(zse, counter) && zcbor_map_end_encode(zse, 1);
-
-		if (!ok) {
-			LOG_ERR("Failed to encode CBOR.");
-			return;
-		}
+	IF_ENABLED(CONFIG_ALUDEL_BATTERY_MONITOR, (read_and_report_battery(client);));
+
+	/* Traffic and energy counters, sent alongside the battery data */
+	app_acct_report(client);
+
+	/* Publish the reading, observers stream, buffer and display it. Bulk
+	 * traffic is held during a firmware download, so the backlog buffers
+	 * readings meanwhile.
+	 */
+	struct app_bus_sample sample = {
+		.timestamp = k_uptime_get(),
+		.counter = counter,
+		.live = app_bus_is_connected() &&
+			!(IS_ENABLED(CONFIG_APP_BACKLOG) && app_ota_is_downloading()),
+	};
+
+	err = zbus_chan_pub(&app_sample_chan, &sample, APP_BUS_PUB_TIMEOUT);
+	if (err) {
+		LOG_ERR("Failed to publish sample: %d", err);
+	}
 
-		size_t cbor_size = zse->payload - cbor_buf;
+	/* Increment for the next run */
+	++counter;
+}
 
-		LOG_DBG("Streaming counter: %d", counter);
+/*
+ * Read a single sample for a burst capture (see app_capture.h). This demo has
+ * no real sensor, so the reading is simulated at the time of the call: the
+ * counter plus a 1 Hz triangle wave, so consecutive samples differ.
+ */
+uint16_t app_sensors_sample(void)
+{
+	uint32_t phase_ms = k_uptime_get_32() % MSEC_PER_SEC;
+	uint32_t wave = (phase_ms < MSEC_PER_SEC / 2) ? phase_ms : (MSEC_PER_SEC - phase_ms);
 
-		/* Stream data to Golioth */
-		err = golioth_stream_set_async(client, "sensor", GOLIOTH_CONTENT_TYPE_CBOR,
-					       cbor_buf, cbor_size, async_error_handler, NULL);
-		if (err) {
-			LOG_ERR("Failed to send sensor data to Golioth: %d", err);
+	return counter + wave;
+}
+
+/* Called from the system work queue when the user button is pressed */
+void app_sensors_report_button(void)
+{
+	static uint32_t presses;
+	struct app_bus_button button = {.presses = ++presses};
+	int err;
+
+	err = zbus_chan_pub(&app_button_chan, &button, APP_BUS_PUB_TIMEOUT);
+	if (err) {
+		LOG_ERR("Failed to publish button press: %d", err);
+	}
+}
+
+static void stream_sample(const struct app_bus_sample *sample)
+{
+	uint8_t cbor_buf[13];
+	int err;
+
+	/* Only stream live readings, the backlog buffers the others */
+	if (!sample->live) {
+		if (!IS_ENABLED(CONFIG_APP_BACKLOG)) {
+			LOG_DBG("No connection available, skipping streaming counter");
 		}
-	} else {
-		LOG_DBG("No connection available, skipping streaming counter: %d", counter);
+		return;
 	}
 
-	/* Golioth custom hardware for demos */
-	IF_ENABLED(CONFIG_LIB_OSTENTUS, (
-		/* Update slide values on Ostentus
-		 *  -values should be sent as strings
-		 *  -use the enum from app_sensors.h for slide key values
-		 */
-		char sbuf[32];
-
-		snprintk(sbuf, sizeof(sbuf), "%d", counter);
-		ostentus_slide_set(o_dev, UP_COUNTER, sbuf, strlen(sbuf));
-		snprintk(sbuf, sizeof(sbuf), "%d", 65535 - counter);
-		ostentus_slide_set(o_dev, DN_COUNTER, sbuf, strlen(sbuf));
-	));
+	/* Encode sensor data using CBOR serialization */
+	uint16_t value = sample->counter;
+	size_t cbor_size;
 
-	/* Increment for the next run */
-	++counter;
+	err = app_codec_sample_encode(APP_SENSORS_COUNTER_KEY, value, cbor_buf, sizeof(cbor_buf),
+				      &cbor_size);
+	if (err) {
+		LOG_ERR("Failed to encode CBOR.");
+		return;
+	}
+
+	LOG_DBG("Streaming counter: %d", value);
+
+	/* Queue data for the next bulk uplink batch */
+	err = app_uplink_send(APP_UPLINK_BULK, APP_UPLINK_SVC_STREAM, APP_SENSORS_STREAM_PATH,
+			      GOLIOTH_CONTENT_TYPE_CBOR, cbor_buf, cbor_size);
+	if (err) {
+		LOG_ERR("Failed to queue sensor data for Golioth: %d", err);
+	}
 }
 
+static void stream_button(const struct app_bus_button *button)
+{
+	uint8_t cbor_buf[16];
+	int err;
+
+	ZCBOR_STATE_E(zse, 1, cbor_buf, sizeof(cbor_buf), 1);
+
+	bool ok = zcbor_map_start_encode(zse, 1) && zcbor_tstr_put_lit(zse, "button") &&
+		  zcbor_uint32_put(zse, button->presses) && zcbor_map_end_encode(zse, 1);
+	if (!ok) {
+		LOG_ERR("Failed to encode CBOR.");
+		return;
+	}
+
+	/* Button events bypass batching and are sent as soon as possible */
+	err = app_uplink_send(APP_UPLINK_URGENT, APP_UPLINK_SVC_STREAM, "event",
+			      GOLIOTH_CONTENT_TYPE_CBOR, cbor_buf, zse->payload - cbor_buf);
+	if (err) {
+		LOG_ERR("Failed to queue button event for Golioth: %d", err);
+	}
+}
+
+ZBUS_MSG_SUBSCRIBER_DEFINE(sensors_uplink_sub);
+ZBUS_CHAN_ADD_OBS(app_sample_chan, sensors_uplink_sub, 1);
+ZBUS_CHAN_ADD_OBS(app_button_chan, sensors_uplink_sub, 1);
+
+/* Uplink observer, encodes readings and button presses off the producer threads */
+static void sensors_uplink_thread(void *p1, void *p2, void *p3)
+{
+	const struct zbus_channel *chan;
+	union {
+		struct app_bus_sample sample;
+		struct app_bus_button button;
+	} msg;
+
+	while (zbus_sub_wait_msg(&sensors_uplink_sub, &chan, &msg, K_FOREVER) == 0) {
+		if (chan == &app_sample_chan) {
+			stream_sample(&msg.sample);
+		} else if (chan == &app_button_chan) {
+			stream_button(&msg.button);
+		}
+	}
+}
+
+K_THREAD_DEFINE(sensors_uplink_tid, CONFIG_APP_BUS_OBSERVER_STACK_SIZE, sensors_uplink_thread,
+		NULL, NULL, NULL, CONFIG_APP_BUS_OBSERVER_THREAD_PRIORITY, 0, 0);
+
 void app_sensors_set_client(struct golioth_client *sensors_client)
 {
 	client = sensors_client;
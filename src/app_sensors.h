@@ -13,17 +13,27 @@
  *
  * For this demonstration, a `counter` value is periodically logged and pushed
  * to the Golioth time-series database. This simulated sensor reading occurs
- * when the loop in `main.c` calls `app_sensors_read_and_stream()`. The
+ * when the loop in `main.c` calls `app_sensors_read_and_publish()`. The
  * frequency of this loop is determined by values received from the Golioth
  * Settings Service (see app_settings.h).
  *
+ * Readings and button presses are published on the event bus (see
+ * app_bus.h). The uplink observer in this file queues readings as bulk traffic
+ * and button presses as urgent events on the uplink scheduler (see
+ * app_uplink.h).
+ *
  * https://docs.golioth.io/firmware/zephyr-device-sdk/light-db-stream/
  */
 
 #include <golioth/client.h>
 
 void app_sensors_set_client(struct golioth_client *sensors_client);
-void app_sensors_read_and_stream(void);
+void app_sensors_read_and_publish(void);
+void app_sensors_report_button(void);
+uint16_t app_sensors_sample(void);
+
+#define APP_SENSORS_STREAM_PATH "sensor"
+#define APP_SENSORS_COUNTER_KEY "counter"
 
 #define LABEL_UP_COUNTER "Counter"
 #define LABEL_DN_COUNTER "Anti-counter"
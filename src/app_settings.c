@@ -9,23 +9,46 @@ LOG_MODULE_REGISTER(app_settings, LOG_LEVEL_DBG);
 
 #include <golioth/client.h>
 #include <golioth/settings.h>
-#include "main.h"
+#include <zephyr/zbus/zbus.h>
+#include "app_acct.h"
+#include "app_bus.h"
+#include "app_codec.h"
 #include "app_settings.h"
 
 static int32_t _loop_delay_s = 60;
-#define LOOP_DELAY_S_MAX 43200
-#define LOOP_DELAY_S_MIN 1
+#define LOOP_DELAY_S_MAX APP_CODEC_LOOP_DELAY_S_MAX
+#define LOOP_DELAY_S_MIN APP_CODEC_LOOP_DELAY_S_MIN
 
 int32_t get_loop_delay_s(void)
 {
 	return _loop_delay_s;
 }
 
+void set_loop_delay_s(int32_t loop_delay_s)
+{
+	_loop_delay_s = CLAMP(loop_delay_s, LOOP_DELAY_S_MIN, LOOP_DELAY_S_MAX);
+}
+
 static enum golioth_settings_status on_loop_delay_setting(int32_t new_value, void *arg)
 {
+	struct app_bus_settings settings = {.loop_delay_s = new_value};
+	int err;
+
+	app_acct_rx(APP_ACCT_SETTINGS, 1, sizeof(new_value));
+
+	if (app_codec_loop_delay_check(new_value)) {
+		LOG_ERR("Loop delay of %i seconds is out of range", new_value);
+		return GOLIOTH_SETTINGS_VALUE_OUT_OF_RANGE;
+	}
+
 	_loop_delay_s = new_value;
 	LOG_INF("Set loop delay to %i seconds", new_value);
-	wake_system_thread();
+
+	/* Wakes the main loop so the new delay applies right away */
+	err = zbus_chan_pub(&app_settings_chan, &settings, APP_BUS_PUB_TIMEOUT);
+	if (err) {
+		LOG_ERR("Failed to publish settings change: %d", err);
+	}
 	return GOLIOTH_SETTINGS_SUCCESS;
 }
 
@@ -22,6 +22,7 @@
 #include <golioth/client.h>
 
 int32_t get_loop_delay_s(void);
+void set_loop_delay_s(int32_t loop_delay_s);
 int app_settings_register(struct golioth_client *client);
 
 #endif /* __APP_SETTINGS_H__ */
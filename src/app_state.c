@@ -9,52 +9,41 @@ LOG_MODULE_REGISTER(app_state, LOG_LEVEL_DBG);
 
 #include <golioth/client.h>
 #include <golioth/lightdb_state.h>
-#include <zephyr/data/json.h>
 #include <zephyr/kernel.h>
-#include "json_helper.h"
+#include <zephyr/zbus/zbus.h>
 
+#include "app_acct.h"
+#include "app_bus.h"
+#include "app_codec.h"
 #include "app_state.h"
 #include "app_sensors.h"
-
-#define DEVICE_STATE_FMT "{\"example_int0\":%d,\"example_int1\":%d}"
+#include "app_uplink.h"
 
 uint32_t _example_int0;
 uint32_t _example_int1 = 1;
 
 static struct golioth_client *client;
 
-static void async_handler(struct golioth_client *client,
-			  enum golioth_status status,
-			  const struct golioth_coap_rsp_code *coap_rsp_code,
-			  const char *path,
-			  void *arg)
-{
-	if (status != GOLIOTH_OK) {
-		LOG_WRN("Failed to set state: %d", status);
-		return;
-	}
-
-	LOG_DBG("State successfully set");
-}
-
 int app_state_reset_desired(void)
 {
 	LOG_INF("Resetting \"%s\" LightDB State endpoint to defaults.", APP_STATE_DESIRED_ENDP);
 
-	char sbuf[sizeof(DEVICE_STATE_FMT) + 4]; /* space for two "-1" values */
+	char sbuf[APP_CODEC_STATE_MAX_LEN];
+	int len = app_codec_state_format(sbuf, sizeof(sbuf), -1, -1);
 
-	snprintk(sbuf, sizeof(sbuf), DEVICE_STATE_FMT, -1, -1);
+	if (len < 0) {
+		return len;
+	}
 
 	int err;
-	err = golioth_lightdb_set_async(client,
-					APP_STATE_DESIRED_ENDP,
-					GOLIOTH_CONTENT_TYPE_JSON,
-					sbuf,
-					strlen(sbuf),
-					async_handler,
-					NULL);
+	err = app_uplink_send(APP_UPLINK_STATE,
+			      APP_UPLINK_SVC_LIGHTDB,
+			      APP_STATE_DESIRED_ENDP,
+			      GOLIOTH_CONTENT_TYPE_JSON,
+			      sbuf,
+			      len);
 	if (err) {
-		LOG_ERR("Unable to write to LightDB State: %d", err);
+		LOG_ERR("Unable to queue LightDB State write: %d", err);
 	}
 	return err;
 }
@@ -62,22 +51,24 @@ int app_state_reset_desired(void)
 int app_state_update_actual(void)
 {
 
-	char sbuf[sizeof(DEVICE_STATE_FMT) + 10]; /* space for uint16 values */
+	char sbuf[APP_CODEC_STATE_MAX_LEN];
+	int len = app_codec_state_format(sbuf, sizeof(sbuf), _example_int0, _example_int1);
 
-	snprintk(sbuf, sizeof(sbuf), DEVICE_STATE_FMT, _example_int0, _example_int1);
+	if (len < 0) {
+		return len;
+	}
 
 	int err;
 
-	err = golioth_lightdb_set_async(client,
-					APP_STATE_ACTUAL_ENDP,
-					GOLIOTH_CONTENT_TYPE_JSON,
-					sbuf,
-					strlen(sbuf),
-					async_handler,
-					NULL);
+	err = app_uplink_send(APP_UPLINK_STATE,
+			      APP_UPLINK_SVC_LIGHTDB,
+			      APP_STATE_ACTUAL_ENDP,
+			      GOLIOTH_CONTENT_TYPE_JSON,
+			      sbuf,
+			      len);
 
 	if (err) {
-		LOG_ERR("Unable to write to LightDB State: %d", err);
+		LOG_ERR("Unable to queue LightDB State write: %d", err);
 	}
 	return err;
 }
@@ -96,63 +87,59 @@ static void app_state_desired_handler(struct golioth_client *client, enum goliot
 	}
 
 	LOG_HEXDUMP_DBG(payload, payload_size, APP_STATE_DESIRED_ENDP);
+	app_acct_rx(APP_ACCT_STATE, 1, payload_size);
 
-	struct app_state parsed_state;
-
-	ret = json_obj_parse((char *)payload, payload_size, app_state_descr,
-			     ARRAY_SIZE(app_state_descr), &parsed_state);
+	struct app_codec_desired desired;
 
+	ret = app_codec_desired_decode(payload, payload_size, &desired);
 	if (ret < 0) {
 		LOG_ERR("Error parsing desired values: %d", ret);
 		app_state_reset_desired();
 		return;
 	}
 
-	uint8_t desired_processed_count = 0;
 	uint8_t state_change_count = 0;
 
-	if (ret & 1 << 0) {
-		/* Process example_int0 */
-		if ((parsed_state.example_int0 >= 0) && (parsed_state.example_int0 < 65536)) {
-			LOG_DBG("Validated desired example_int0 value: %d",
-				parsed_state.example_int0);
-			if (_example_int0 != parsed_state.example_int0) {
-				_example_int0 = parsed_state.example_int0;
-				++state_change_count;
-			}
-			++desired_processed_count;
-		} else if (parsed_state.example_int0 == -1) {
-			LOG_DBG("No change requested for example_int0");
-		} else {
-			LOG_ERR("Invalid desired example_int0 value: %d",
-				parsed_state.example_int0);
-			++desired_processed_count;
+	if (desired.valid & APP_CODEC_DESIRED_INT0) {
+		LOG_DBG("Validated desired example_int0 value: %d", desired.example_int0);
+		if (_example_int0 != desired.example_int0) {
+			_example_int0 = desired.example_int0;
+			++state_change_count;
 		}
+	} else if (desired.processed & APP_CODEC_DESIRED_INT0) {
+		LOG_ERR("Invalid desired example_int0 value: %d", desired.example_int0);
+	} else if (desired.present & APP_CODEC_DESIRED_INT0) {
+		LOG_DBG("No change requested for example_int0");
 	}
-	if (ret & 1 << 1) {
-		/* Process example_int1 */
-		if ((parsed_state.example_int1 >= 0) && (parsed_state.example_int1 < 65536)) {
-			LOG_DBG("Validated desired example_int1 value: %d",
-				parsed_state.example_int1);
-			if (_example_int1 != parsed_state.example_int1) {
-				_example_int1 = parsed_state.example_int1;
-				++state_change_count;
-			}
-			++desired_processed_count;
-		} else if (parsed_state.example_int1 == -1) {
-			LOG_DBG("No change requested for example_int1");
-		} else {
-			LOG_ERR("Invalid desired example_int1 value: %d",
-				parsed_state.example_int1);
-			++desired_processed_count;
+
+	if (desired.valid & APP_CODEC_DESIRED_INT1) {
+		LOG_DBG("Validated desired example_int1 value: %d", desired.example_int1);
+		if (_example_int1 != desired.example_int1) {
+			_example_int1 = desired.example_int1;
+			++state_change_count;
 		}
+	} else if (desired.processed & APP_CODEC_DESIRED_INT1) {
+		LOG_ERR("Invalid desired example_int1 value: %d", desired.example_int1);
+	} else if (desired.present & APP_CODEC_DESIRED_INT1) {
+		LOG_DBG("No change requested for example_int1");
 	}
 
 	if (state_change_count) {
+		struct app_bus_state state = {
+			.example_int0 = _example_int0,
+			.example_int1 = _example_int1,
+		};
+
+		/* Let other modules act on the new state */
+		ret = zbus_chan_pub(&app_state_chan, &state, APP_BUS_PUB_TIMEOUT);
+		if (ret) {
+			LOG_ERR("Failed to publish state change: %d", ret);
+		}
+
 		/* The state was changed, so update the state on the Golioth servers */
 		err = app_state_update_actual();
 	}
-	if (desired_processed_count) {
+	if (desired.processed) {
 		/* We processed some desired changes to return these to -1 on the server
 		 * to indicate the desired values were received.
 		 */
@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2026 Golioth, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(app_txwin, LOG_LEVEL_DBG);
+
+#include <zephyr/kernel.h>
+#include <zephyr/spinlock.h>
+#include <zephyr/sys/atomic.h>
+
+#include "app_txwin.h"
+#include "app_uplink.h"
+
+#define TXWIN_POLL K_MSEC(500)
+
+static uint32_t period_s = CONFIG_APP_TXWIN_PERIOD_S;
+static atomic_t radio_active;
+
+/* Only changed from the work handler, the lock keeps stats readers consistent */
+static struct app_txwin_stats stats;
+static int64_t opened_at;
+static int64_t next_window;
+static struct k_spinlock lock;
+
+static void txwin_work_handler(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(txwin_work, txwin_work_handler);
+
+static bool uplink_queues_empty(void)
+{
+	return (app_uplink_free_get(APP_UPLINK_STATE) == CONFIG_APP_UPLINK_STATE_QUEUE_LEN) &&
+	       (app_uplink_free_get(APP_UPLINK_BULK) == CONFIG_APP_UPLINK_BULK_QUEUE_LEN);
+}
+
+static void txwin_open(int64_t now, bool piggyback)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	stats.open = true;
+	stats.windows++;
+	stats.piggybacked += piggyback ? 1 : 0;
+	opened_at = now;
+	next_window = now + (int64_t)period_s * MSEC_PER_SEC;
+	stats.next_window_s = next_window / MSEC_PER_SEC;
+
+	k_spin_unlock(&lock, key);
+
+	LOG_DBG("Transmit window open%s", piggyback ? " (radio already active)" : "");
+
+	app_uplink_hold(APP_UPLINK_STATE, false);
+	app_uplink_flush();
+}
+
+static void txwin_close(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	stats.open = false;
+
+	k_spin_unlock(&lock, key);
+
+	LOG_DBG("Transmit window closed after %u ms", (uint32_t)(k_uptime_get() - opened_at));
+
+	app_uplink_hold(APP_UPLINK_STATE, true);
+}
+
+static void txwin_work_handler(struct k_work *work)
+{
+	int64_t now = k_uptime_get();
+	bool piggyback = atomic_clear(&radio_active);
+
+	if (stats.open) {
+		if (uplink_queues_empty() ||
+		    (now - opened_at >= CONFIG_APP_TXWIN_MAX_OPEN_S * MSEC_PER_SEC)) {
+			txwin_close();
+			k_work_reschedule(&txwin_work, K_MSEC(MAX(next_window - now, 0)));
+		} else {
+			k_work_reschedule(&txwin_work, TXWIN_POLL);
+		}
+		return;
+	}
+
+	if (now >= next_window) {
+		txwin_open(now, false);
+	} else if (piggyback && (next_window - now <= CONFIG_APP_TXWIN_EARLY_S * MSEC_PER_SEC)) {
+		txwin_open(now, true);
+	} else {
+		k_work_reschedule(&txwin_work, K_MSEC(next_window - now));
+		return;
+	}
+
+	k_work_reschedule(&txwin_work, TXWIN_POLL);
+}
+
+void app_txwin_period_set(uint32_t txwin_period_s)
+{
+	period_s = txwin_period_s;
+}
+
+void app_txwin_init(void)
+{
+	if (period_s == 0) {
+		LOG_INF("Transmit windows disabled");
+		return;
+	}
+
+	next_window = k_uptime_get() + (int64_t)period_s * MSEC_PER_SEC;
+	stats.next_window_s = next_window / MSEC_PER_SEC;
+
+	app_uplink_hold(APP_UPLINK_STATE, true);
+	k_work_schedule(&txwin_work, K_SECONDS(period_s));
+}
+
+void app_txwin_radio_active(void)
+{
+	if ((period_s == 0) || stats.open) {
+		return;
+	}
+
+	atomic_set(&radio_active, true);
+	k_work_reschedule(&txwin_work, K_NO_WAIT);
+}
+
+void app_txwin_stats_get(struct app_txwin_stats *txwin_stats)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	*txwin_stats = stats;
+
+	k_spin_unlock(&lock, key);
+}
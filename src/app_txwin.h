@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2026 Golioth, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/** Align non-urgent uplinks to transmit windows.
+ *
+ * On LTE-M and NB-IoT every isolated transmission keeps the radio in RRC
+ * connected mode for the network's inactivity timer, which costs far more
+ * energy than the bytes sent. Outside of a transmit window, state and bulk
+ * traffic is held in the uplink scheduler (see app_uplink.h). Every
+ * `CONFIG_APP_TXWIN_PERIOD_S` a window opens, releases everything that queued
+ * up in one burst and closes again once the queues are empty or after
+ * `CONFIG_APP_TXWIN_MAX_OPEN_S`.
+ *
+ * When the radio wakes up for another reason within `CONFIG_APP_TXWIN_EARLY_S`
+ * of the next window (an urgent message, a tracking area update at the end
+ * of a PSM cycle, registration), call `app_txwin_radio_active()` and the
+ * window opens right away to share the connected period. The next window is
+ * then scheduled a full period later.
+ *
+ * Urgent traffic is never held. Log messages are sent by the Golioth log
+ * backend directly and are not held either.
+ */
+
+#ifndef __APP_TXWIN_H__
+#define __APP_TXWIN_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+
+struct app_txwin_stats {
+	bool open;
+	uint32_t windows;
+	uint32_t piggybacked;
+	uint32_t next_window_s;
+};
+
+/** Override `CONFIG_APP_TXWIN_PERIOD_S` before `app_txwin_init()`, 0 disables windows */
+void app_txwin_period_set(uint32_t period_s);
+
+/** Start holding traffic until the first window */
+void app_txwin_init(void);
+
+/** Report that the radio is connected anyway, may open the next window early */
+void app_txwin_radio_active(void);
+
+void app_txwin_stats_get(struct app_txwin_stats *stats);
+
+#endif /* __APP_TXWIN_H__ */
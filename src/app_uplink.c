@@ -0,0 +1,585 @@
+/*
+ * Copyright (c) 2026 Golioth, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(app_uplink, LOG_LEVEL_DBG);
+
+#include <errno.h>
+#include <string.h>
+#include <golioth/client.h>
+#include <golioth/lightdb_state.h>
+#include <golioth/stream.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log_backend.h>
+#include <zephyr/logging/log_ctrl.h>
+#include <zephyr/spinlock.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/zbus/zbus.h>
+
+#include "app_acct.h"
+#include "app_bus.h"
+#include "app_codec.h"
+#include "app_uplink.h"
+
+#define GOLIOTH_LOG_BACKEND_NAME "log_backend_golioth"
+
+BUILD_ASSERT(CONFIG_APP_UPLINK_MAX_INFLIGHT >= 2,
+	     "At least one in-flight slot must remain reserved for urgent traffic");
+
+struct uplink_msg {
+	int64_t queued_at;
+	uint16_t len;
+	/* Offset of an age to advance when sending, 0 for none */
+	uint16_t age_offset;
+	uint8_t svc;
+	uint8_t content_type;
+	char path[CONFIG_APP_UPLINK_PATH_MAX_LEN];
+	uint8_t payload[CONFIG_APP_UPLINK_PAYLOAD_MAX_LEN];
+};
+
+K_MSGQ_DEFINE(urgent_q, sizeof(struct uplink_msg), CONFIG_APP_UPLINK_URGENT_QUEUE_LEN, 8);
+K_MSGQ_DEFINE(state_q, sizeof(struct uplink_msg), CONFIG_APP_UPLINK_STATE_QUEUE_LEN, 8);
+K_MSGQ_DEFINE(bulk_q, sizeof(struct uplink_msg), CONFIG_APP_UPLINK_BULK_QUEUE_LEN, 8);
+
+struct uplink_class {
+	const char *name;
+	struct k_msgq *q;
+	bool drop_oldest;
+	int inflight;
+	atomic_t holds;
+	atomic_t queued;
+	atomic_t sent;
+	atomic_t dropped;
+	atomic_t failed;
+	atomic_t bytes;
+	uint64_t latency_sum_ms;
+	uint32_t latency_count;
+	uint32_t latency_max_ms;
+	uint32_t latency_hist[APP_UPLINK_LATENCY_BUCKETS];
+};
+
+static struct uplink_class classes[APP_UPLINK_CLASS_COUNT] = {
+	[APP_UPLINK_URGENT] = {
+		.name = "urgent",
+		.q = &urgent_q,
+		.drop_oldest = IS_ENABLED(CONFIG_APP_UPLINK_URGENT_DROP_OLDEST),
+	},
+	[APP_UPLINK_STATE] = {
+		.name = "state",
+		.q = &state_q,
+		.drop_oldest = IS_ENABLED(CONFIG_APP_UPLINK_STATE_DROP_OLDEST),
+	},
+	[APP_UPLINK_BULK] = {
+		.name = "bulk",
+		.q = &bulk_q,
+		.drop_oldest = IS_ENABLED(CONFIG_APP_UPLINK_BULK_DROP_OLDEST),
+	},
+};
+
+struct uplink_inflight {
+	bool used;
+	uint8_t cls;
+	int64_t queued_at;
+};
+
+static struct uplink_inflight inflight[CONFIG_APP_UPLINK_MAX_INFLIGHT];
+static int inflight_total;
+static struct k_spinlock lock;
+
+static struct golioth_client *client;
+K_SEM_DEFINE(uplink_sem, 0, 1);
+
+/* Only touched by the scheduler thread */
+static struct uplink_msg scratch;
+static bool bulk_release;
+
+static atomic_t bulk_flush;
+
+/* Active caps on the Golioth log backend level, counted per level */
+static atomic_t log_limits[LOG_LEVEL_DBG + 1];
+static int applied_log_limit = -1;
+/* Golioth backend level of each source without caps, as compiled in or requested at runtime */
+static uint8_t requested_log_levels[CONFIG_APP_UPLINK_LOG_SOURCES_MAX];
+static bool requested_log_levels_init;
+K_MUTEX_DEFINE(log_limit_mutex);
+
+static struct uplink_inflight *inflight_alloc(enum app_uplink_class cls, int64_t queued_at)
+{
+	struct uplink_inflight *slot = NULL;
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	for (int i = 0; i < ARRAY_SIZE(inflight); i++) {
+		if (!inflight[i].used) {
+			slot = &inflight[i];
+			slot->used = true;
+			slot->cls = cls;
+			slot->queued_at = queued_at;
+			classes[cls].inflight++;
+			inflight_total++;
+			break;
+		}
+	}
+
+	k_spin_unlock(&lock, key);
+
+	return slot;
+}
+
+static void inflight_free(struct uplink_inflight *slot, bool acked)
+{
+	int64_t now = k_uptime_get();
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	struct uplink_class *c = &classes[slot->cls];
+
+	if (acked) {
+		uint32_t latency_ms = (uint32_t)(now - slot->queued_at);
+
+		c->latency_sum_ms += latency_ms;
+		c->latency_count++;
+		c->latency_max_ms = MAX(c->latency_max_ms, latency_ms);
+
+		/* Bucket n counts latencies below 2^n ms, the last bucket is open ended */
+		int bucket = (latency_ms == 0) ? 0 : (32 - __builtin_clz(latency_ms));
+
+		c->latency_hist[MIN(bucket, APP_UPLINK_LATENCY_BUCKETS - 1)]++;
+	}
+
+	c->inflight--;
+	inflight_total--;
+	slot->used = false;
+
+	k_spin_unlock(&lock, key);
+}
+
+static bool has_capacity(enum app_uplink_class cls)
+{
+	bool ok;
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	switch (cls) {
+	case APP_UPLINK_URGENT:
+		ok = inflight_total < CONFIG_APP_UPLINK_MAX_INFLIGHT;
+		break;
+	case APP_UPLINK_BULK:
+		ok = (inflight_total < CONFIG_APP_UPLINK_MAX_INFLIGHT - 1) &&
+		     (classes[cls].inflight < CONFIG_APP_UPLINK_BULK_MAX_INFLIGHT);
+		break;
+	default:
+		ok = inflight_total < CONFIG_APP_UPLINK_MAX_INFLIGHT - 1;
+		break;
+	}
+
+	k_spin_unlock(&lock, key);
+
+	return ok;
+}
+
+static void uplink_async_handler(struct golioth_client *client, enum golioth_status status,
+				 const struct golioth_coap_rsp_code *coap_rsp_code,
+				 const char *path, void *arg)
+{
+	struct uplink_inflight *slot = arg;
+	struct uplink_class *c = &classes[slot->cls];
+
+	if (status == GOLIOTH_OK) {
+		atomic_inc(&c->sent);
+		LOG_DBG("Sent %s message to %s", c->name, path);
+	} else {
+		atomic_inc(&c->failed);
+		LOG_WRN("Failed to send %s message to %s: %d", c->name, path, status);
+	}
+
+	inflight_free(slot, status == GOLIOTH_OK);
+
+	/* A slot was freed, let the scheduler release the next message */
+	k_sem_give(&uplink_sem);
+}
+
+static int uplink_dispatch(enum app_uplink_class cls, struct uplink_msg *msg)
+{
+	struct uplink_inflight *slot = inflight_alloc(cls, msg->queued_at);
+	int err;
+
+	if (!slot) {
+		return -EBUSY;
+	}
+
+	if (msg->age_offset &&
+	    app_codec_age_add(msg->payload, msg->len, msg->age_offset,
+			      (k_uptime_get() - msg->queued_at) / MSEC_PER_SEC)) {
+		LOG_WRN("No age at offset %u of message to %s", msg->age_offset, msg->path);
+	}
+
+	if (msg->svc == APP_UPLINK_SVC_LIGHTDB) {
+		err = golioth_lightdb_set_async(client, msg->path, msg->content_type, msg->payload,
+						msg->len, uplink_async_handler, slot);
+	} else {
+		err = golioth_stream_set_async(client, msg->path, msg->content_type, msg->payload,
+					       msg->len, uplink_async_handler, slot);
+	}
+
+	if (err) {
+		LOG_ERR("Failed to send %s message to %s: %d", classes[cls].name, msg->path, err);
+		atomic_inc(&classes[cls].failed);
+		inflight_free(slot, false);
+	} else {
+		atomic_add(&classes[cls].bytes, msg->len);
+		app_acct_tx((msg->svc == APP_UPLINK_SVC_LIGHTDB) ? APP_ACCT_STATE
+								  : APP_ACCT_STREAM,
+			    1, msg->len);
+	}
+
+	return err;
+}
+
+/* A hold on a class also holds every class of lower priority */
+static bool is_held(enum app_uplink_class cls)
+{
+	for (int i = APP_UPLINK_URGENT + 1; i <= cls; i++) {
+		if (atomic_get(&classes[i].holds)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/* Release messages of one class while in-flight slots allow it */
+static bool uplink_drain(enum app_uplink_class cls)
+{
+	bool sent = false;
+
+	while (has_capacity(cls) && (k_msgq_get(classes[cls].q, &scratch, K_NO_WAIT) == 0)) {
+		if (uplink_dispatch(cls, &scratch) == 0) {
+			sent = true;
+		}
+	}
+
+	return sent;
+}
+
+/* Run one scheduling pass and return how long to wait before the next one */
+static k_timeout_t uplink_service(void)
+{
+	bool priority_sent;
+
+	if (!client || !golioth_client_is_connected(client)) {
+		/* Hold everything until app_uplink_kick() reports a connection */
+		return K_FOREVER;
+	}
+
+	priority_sent = uplink_drain(APP_UPLINK_URGENT);
+
+	if ((k_msgq_num_used_get(&urgent_q) == 0) && !is_held(APP_UPLINK_STATE)) {
+		priority_sent |= uplink_drain(APP_UPLINK_STATE);
+	}
+
+	if (k_msgq_num_used_get(&urgent_q) || k_msgq_num_used_get(&state_q)) {
+		/* Waiting for in-flight slots or a hold; both wake the thread */
+		return K_FOREVER;
+	}
+
+	if (k_msgq_num_used_get(&bulk_q) == 0) {
+		/* Nothing left to flush */
+		atomic_clear(&bulk_flush);
+	}
+
+	if ((k_msgq_num_used_get(&bulk_q) == 0) || is_held(APP_UPLINK_BULK)) {
+		bulk_release = false;
+		return K_FOREVER;
+	}
+
+	if (priority_sent || atomic_clear(&bulk_flush) ||
+	    (k_msgq_num_used_get(&bulk_q) >= CONFIG_APP_UPLINK_BULK_BATCH_SIZE)) {
+		bulk_release = true;
+	}
+
+	if (!bulk_release && (k_msgq_peek(&bulk_q, &scratch) == 0)) {
+		int64_t age_ms = k_uptime_get() - scratch.queued_at;
+		int64_t hold_ms = CONFIG_APP_UPLINK_BULK_MAX_HOLD_S * MSEC_PER_SEC;
+
+		if (age_ms < hold_ms) {
+			return K_MSEC(hold_ms - age_ms);
+		}
+
+		bulk_release = true;
+	}
+
+	uplink_drain(APP_UPLINK_BULK);
+
+	if (k_msgq_num_used_get(&bulk_q) == 0) {
+		bulk_release = false;
+	}
+
+	return K_FOREVER;
+}
+
+/* Keep Golioth logs from competing with urgent and state traffic for the link */
+static void uplink_log_gate(void)
+{
+	static bool limited;
+	bool pending = false;
+
+	if (client && golioth_client_is_connected(client)) {
+		k_spinlock_key_t key = k_spin_lock(&lock);
+
+		pending = (classes[APP_UPLINK_URGENT].inflight > 0) ||
+			  (!is_held(APP_UPLINK_STATE) && (classes[APP_UPLINK_STATE].inflight > 0));
+
+		k_spin_unlock(&lock, key);
+
+		pending = pending || k_msgq_num_used_get(&urgent_q) ||
+			  (!is_held(APP_UPLINK_STATE) && k_msgq_num_used_get(&state_q));
+	}
+
+	if (pending != limited) {
+		limited = pending;
+		app_uplink_log_limit(CONFIG_APP_UPLINK_PRIORITY_LOG_LEVEL, pending);
+	}
+}
+
+static void uplink_thread(void *p1, void *p2, void *p3)
+{
+	while (true) {
+		k_timeout_t timeout = uplink_service();
+
+		uplink_log_gate();
+		k_sem_take(&uplink_sem, timeout);
+	}
+}
+
+K_THREAD_DEFINE(uplink_tid, CONFIG_APP_UPLINK_STACK_SIZE, uplink_thread, NULL, NULL, NULL,
+		CONFIG_APP_UPLINK_THREAD_PRIORITY, 0, 0);
+
+int app_uplink_send_aged(enum app_uplink_class cls, enum app_uplink_service svc,
+			 const char *path, enum golioth_content_type content_type,
+			 const uint8_t *buf, size_t len, size_t age_offset)
+{
+	struct uplink_class *c = &classes[cls];
+	struct uplink_msg msg;
+	size_t path_len = strlen(path);
+
+	if ((path_len >= sizeof(msg.path)) || (len > sizeof(msg.payload))) {
+		return -EMSGSIZE;
+	}
+
+	msg.queued_at = k_uptime_get();
+	msg.len = len;
+	msg.age_offset = age_offset;
+	msg.svc = svc;
+	msg.content_type = content_type;
+	memcpy(msg.path, path, path_len + 1);
+	memcpy(msg.payload, buf, len);
+
+	while (k_msgq_put(c->q, &msg, K_NO_WAIT) != 0) {
+		if (!c->drop_oldest) {
+			atomic_inc(&c->dropped);
+			return -ENOBUFS;
+		}
+
+		struct uplink_msg oldest;
+
+		if (k_msgq_get(c->q, &oldest, K_NO_WAIT) == 0) {
+			atomic_inc(&c->dropped);
+		}
+	}
+
+	atomic_inc(&c->queued);
+	k_sem_give(&uplink_sem);
+
+	return 0;
+}
+
+int app_uplink_send(enum app_uplink_class cls, enum app_uplink_service svc, const char *path,
+		    enum golioth_content_type content_type, const uint8_t *buf, size_t len)
+{
+	return app_uplink_send_aged(cls, svc, path, content_type, buf, len, 0);
+}
+
+void app_uplink_kick(void)
+{
+	k_sem_give(&uplink_sem);
+}
+
+/* Release traffic that queued up while disconnected */
+static void uplink_conn_cb(const struct zbus_channel *chan)
+{
+	const struct app_bus_conn *conn = zbus_chan_const_msg(chan);
+
+	if (conn->connected) {
+		app_uplink_kick();
+	}
+}
+
+ZBUS_LISTENER_DEFINE(uplink_conn_lis, uplink_conn_cb);
+ZBUS_CHAN_ADD_OBS(app_conn_chan, uplink_conn_lis, 0);
+
+void app_uplink_flush(void)
+{
+	atomic_set(&bulk_flush, true);
+	k_sem_give(&uplink_sem);
+}
+
+void app_uplink_hold(enum app_uplink_class cls, bool enable)
+{
+	__ASSERT(cls != APP_UPLINK_URGENT, "Urgent traffic cannot be held");
+
+	if (enable) {
+		atomic_inc(&classes[cls].holds);
+	} else {
+		atomic_dec(&classes[cls].holds);
+	}
+
+	k_sem_give(&uplink_sem);
+}
+
+/*
+ * Set every Golioth log source to its requested level, lowered to the strictest
+ * cap. Only sources whose level changes are written. Called with
+ * log_limit_mutex held.
+ */
+static void log_limit_apply(bool force)
+{
+	const struct log_backend *backend;
+	int limit = -1;
+
+	for (int level = 0; level < ARRAY_SIZE(log_limits); level++) {
+		if (atomic_get(&log_limits[level])) {
+			limit = level;
+			break;
+		}
+	}
+
+	if (!force && (limit == applied_log_limit)) {
+		return;
+	}
+
+	backend = log_backend_get_by_name(GOLIOTH_LOG_BACKEND_NAME);
+	if (!backend) {
+		LOG_WRN("Golioth log backend not found");
+		return;
+	}
+
+	uint32_t source_count = log_src_cnt_get(0);
+
+	for (uint32_t id = 0; id < source_count; id++) {
+		uint32_t current = log_filter_get(backend, 0, id, true);
+		uint32_t level;
+
+		if (id >= ARRAY_SIZE(requested_log_levels)) {
+			/* Not tracked, fall back to the compiled in level */
+			level = log_filter_get(backend, 0, id, false);
+		} else {
+			if (!requested_log_levels_init) {
+				/* No cap applied yet, the current level is the requested one */
+				requested_log_levels[id] = current;
+			}
+			level = requested_log_levels[id];
+		}
+
+		if (limit >= 0) {
+			level = MIN(level, limit);
+		}
+
+		if (level != current) {
+			log_filter_set(backend, 0, id, level);
+		}
+	}
+
+	requested_log_levels_init = true;
+	applied_log_limit = limit;
+}
+
+void app_uplink_log_limit(uint8_t level, bool enable)
+{
+	if (!IS_ENABLED(CONFIG_LOG_RUNTIME_FILTERING)) {
+		return;
+	}
+
+	level = MIN(level, LOG_LEVEL_DBG);
+
+	k_mutex_lock(&log_limit_mutex, K_FOREVER);
+
+	if (enable) {
+		atomic_inc(&log_limits[level]);
+	} else {
+		atomic_dec(&log_limits[level]);
+	}
+
+	log_limit_apply(false);
+
+	k_mutex_unlock(&log_limit_mutex);
+}
+
+int app_uplink_log_level_set(uint8_t level)
+{
+	const struct log_backend *golioth_backend;
+	uint32_t source_count = log_src_cnt_get(0);
+
+	if (!IS_ENABLED(CONFIG_LOG_RUNTIME_FILTERING)) {
+		return -ENOTSUP;
+	}
+
+	k_mutex_lock(&log_limit_mutex, K_FOREVER);
+
+	golioth_backend = log_backend_get_by_name(GOLIOTH_LOG_BACKEND_NAME);
+
+	for (uint32_t id = 0; id < source_count; id++) {
+		/* The Golioth backend is set below, without lifting active caps */
+		for (int i = 0; i < log_backend_count_get(); i++) {
+			const struct log_backend *backend = log_backend_get(i);
+
+			if (backend != golioth_backend) {
+				log_filter_set(backend, 0, id, level);
+			}
+		}
+
+		if (id < ARRAY_SIZE(requested_log_levels)) {
+			requested_log_levels[id] = level;
+		}
+	}
+
+	requested_log_levels_init = true;
+	log_limit_apply(true);
+
+	k_mutex_unlock(&log_limit_mutex);
+
+	return source_count;
+}
+
+uint32_t app_uplink_free_get(enum app_uplink_class cls)
+{
+	return k_msgq_num_free_get(classes[cls].q);
+}
+
+void app_uplink_stats_get(enum app_uplink_class cls, struct app_uplink_stats *stats)
+{
+	struct uplink_class *c = &classes[cls];
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	stats->latency_avg_ms = c->latency_count ? (c->latency_sum_ms / c->latency_count) : 0;
+	stats->latency_max_ms = c->latency_max_ms;
+	memcpy(stats->latency_hist, c->latency_hist, sizeof(stats->latency_hist));
+
+	k_spin_unlock(&lock, key);
+
+	stats->queued = atomic_get(&c->queued);
+	stats->sent = atomic_get(&c->sent);
+	stats->dropped = atomic_get(&c->dropped);
+	stats->failed = atomic_get(&c->failed);
+	stats->bytes = atomic_get(&c->bytes);
+}
+
+const char *app_uplink_class_name(enum app_uplink_class cls)
+{
+	return classes[cls].name;
+}
+
+void app_uplink_set_client(struct golioth_client *uplink_client)
+{
+	client = uplink_client;
+	k_sem_give(&uplink_sem);
+}
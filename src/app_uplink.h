@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2026 Golioth, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/** Prioritized scheduler for outbound Stream and LightDB State traffic.
+ *
+ * Messages are queued in one of three traffic classes and released by a
+ * dedicated thread in strict priority order:
+ *
+ * - `APP_UPLINK_URGENT`: alarms and user events (e.g. a button press). Sent as
+ *   soon as the client is connected, bypassing batching.
+ * - `APP_UPLINK_STATE`: LightDB State writes. Sent once no urgent traffic is
+ *   waiting.
+ * - `APP_UPLINK_BULK`: periodic telemetry. Collected into batches and released
+ *   when a batch is full, when the oldest message has been held too long, or
+ *   opportunistically right after higher priority traffic went out.
+ *
+ * Each class has its own bounded queue and drop policy (see the
+ * `CONFIG_APP_UPLINK_*` Kconfig symbols). Latency is measured from the moment
+ * a message is queued until the server acknowledges it and is reported per
+ * class by `app_uplink_stats_get()`.
+ *
+ * Log messages are sent by the Golioth log backend directly and cannot be
+ * queued here. Instead, while urgent or state traffic is waiting or in flight,
+ * the Golioth backend only passes logs at `CONFIG_APP_UPLINK_PRIORITY_LOG_LEVEL`
+ * or more severe, so a log burst cannot get ahead of an alarm. Other modules
+ * cap the level the same way with `app_uplink_log_limit()`.
+ */
+
+#ifndef __APP_UPLINK_H__
+#define __APP_UPLINK_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <golioth/client.h>
+
+enum app_uplink_class {
+	APP_UPLINK_URGENT,
+	APP_UPLINK_STATE,
+	APP_UPLINK_BULK,
+	APP_UPLINK_CLASS_COUNT
+};
+
+enum app_uplink_service {
+	APP_UPLINK_SVC_STREAM,
+	APP_UPLINK_SVC_LIGHTDB,
+};
+
+/* Latency histogram bucket n counts latencies below 2^n ms */
+#define APP_UPLINK_LATENCY_BUCKETS 16
+
+struct app_uplink_stats {
+	uint32_t queued;
+	uint32_t sent;
+	uint32_t dropped;
+	uint32_t failed;
+	uint32_t bytes;
+	uint32_t latency_avg_ms;
+	uint32_t latency_max_ms;
+	uint32_t latency_hist[APP_UPLINK_LATENCY_BUCKETS];
+};
+
+void app_uplink_set_client(struct golioth_client *uplink_client);
+
+/**
+ * Queue a message for uplink. Safe to call from any thread, but not from ISRs.
+ *
+ * The message is copied through a `CONFIG_APP_UPLINK_PAYLOAD_MAX_LEN` +
+ * `CONFIG_APP_UPLINK_PATH_MAX_LEN` + 16 byte buffer on the caller's stack, and
+ * a second one when the oldest message of a full queue is dropped. Size the
+ * stacks of calling threads accordingly.
+ *
+ * @retval 0 message queued (possibly after dropping the oldest one)
+ * @retval -EMSGSIZE path or payload does not fit a queue slot
+ * @retval -ENOBUFS queue full and the class drops the newest message
+ */
+int app_uplink_send(enum app_uplink_class cls, enum app_uplink_service svc, const char *path,
+		    enum golioth_content_type content_type, const uint8_t *buf, size_t len);
+
+/**
+ * Queue a CBOR message holding an age, encoded with `app_codec_age_put()` at
+ * `age_offset` in `buf`. The time the message waited in the queue, whether
+ * batched or held, is added to the age when it is handed to the client, so
+ * the age is correct as of sending. Otherwise the same as `app_uplink_send()`.
+ */
+int app_uplink_send_aged(enum app_uplink_class cls, enum app_uplink_service svc,
+			 const char *path, enum golioth_content_type content_type,
+			 const uint8_t *buf, size_t len, size_t age_offset);
+
+/** Wake the scheduler, e.g. after the client (re)connects */
+void app_uplink_kick(void);
+
+/** Release all queued bulk traffic at once instead of waiting for a full batch */
+void app_uplink_flush(void);
+
+/**
+ * Hold back a class and every class of lower priority until the hold is
+ * released again. Holds nest, each `true` call needs a matching `false` call.
+ * Urgent traffic cannot be held.
+ */
+void app_uplink_hold(enum app_uplink_class cls, bool enable);
+
+/**
+ * Cap the level of logs sent to Golioth, e.g. while bandwidth is scarce.
+ * Caps nest like holds, each `true` call needs a matching `false` call with the
+ * same level. The strictest active cap applies, and the levels set before the
+ * first cap are restored once the last one is released. Local log output is
+ * not affected. Requires `CONFIG_LOG_RUNTIME_FILTERING`.
+ */
+void app_uplink_log_limit(uint8_t level, bool enable);
+
+/**
+ * Set the log level of every source on all backends, e.g. from an RPC. On the
+ * Golioth backend this is the level restored once all caps are released, and
+ * active caps keep applying until then.
+ *
+ * @return number of log sources, or -ENOTSUP without `CONFIG_LOG_RUNTIME_FILTERING`
+ */
+int app_uplink_log_level_set(uint8_t level);
+
+/** Number of messages that can be queued in a class without dropping any */
+uint32_t app_uplink_free_get(enum app_uplink_class cls);
+
+void app_uplink_stats_get(enum app_uplink_class cls, struct app_uplink_stats *stats);
+const char *app_uplink_class_name(enum app_uplink_class cls);
+
+#endif /* __APP_UPLINK_H__ */
@@ -8,15 +8,28 @@
 LOG_MODULE_REGISTER(golioth_rd_template, LOG_LEVEL_DBG);
 
 #include <app_version.h>
+#include "app_bus.h"
+#include "app_ota.h"
 #include "app_rpc.h"
 #include "app_settings.h"
 #include "app_state.h"
 #include "app_sensors.h"
+#include "app_uplink.h"
+#ifdef CONFIG_APP_FLEET_SIM
+#include "app_fleet_sim.h"
+#endif
+#ifdef CONFIG_APP_LINK_SIM
+#include "app_link_sim.h"
+#endif
+#ifdef CONFIG_APP_TXWIN
+#include "app_txwin.h"
+#endif
 #include <golioth/client.h>
 #include <golioth/fw_update.h>
 #include <samples/common/net_connect.h>
 #include <samples/common/sample_credentials.h>
 #include <zephyr/kernel.h>
+#include <zephyr/zbus/zbus.h>
 
 #ifdef CONFIG_SOC_SERIES_NRF91X
 #include <modem/lte_lc.h>
@@ -43,7 +56,10 @@ static const char *_current_version =
 static struct golioth_client *client;
 K_SEM_DEFINE(connected, 0, 1);
 
-static k_tid_t _system_thread = 0;
+/* Wake the main loop early for new settings and button presses */
+ZBUS_SUBSCRIBER_DEFINE(main_sub, CONFIG_APP_BUS_SUB_QUEUE_SIZE);
+ZBUS_CHAN_ADD_OBS(app_settings_chan, main_sub, 0);
+ZBUS_CHAN_ADD_OBS(app_button_chan, main_sub, 0);
 
 #if DT_NODE_EXISTS(DT_ALIAS(golioth_led))
 static const struct gpio_dt_spec golioth_led = GPIO_DT_SPEC_GET(DT_ALIAS(golioth_led), gpios);
@@ -54,21 +70,24 @@ static struct gpio_callback button_cb_data;
 /* forward declarations */
 void golioth_connection_led_set(uint8_t state);
 
-void wake_system_thread(void)
-{
-	k_wakeup(_system_thread);
-}
-
 static void on_client_event(struct golioth_client *client, enum golioth_client_event event,
 			    void *arg)
 {
 	bool is_connected = (event == GOLIOTH_CLIENT_EVENT_CONNECTED);
+	struct app_bus_conn conn = {.connected = is_connected};
+	int err;
 
 	if (is_connected) {
 		k_sem_give(&connected);
 		golioth_connection_led_set(1);
 	}
 	LOG_INF("Golioth client %s", is_connected ? "connected" : "disconnected");
+
+	/* Uplink, statistics and backlog react through the event bus */
+	err = zbus_chan_pub(&app_conn_chan, &conn, APP_BUS_PUB_TIMEOUT);
+	if (err) {
+		LOG_ERR("Failed to publish connection event: %d", err);
+	}
 }
 
 static void start_golioth_client(void)
@@ -76,15 +95,27 @@ static void start_golioth_client(void)
 	/* Get the client configuration from auto-loaded settings */
 	const struct golioth_client_config *client_config = golioth_sample_credentials_get();
 
+	/* Hold non-urgent traffic until the first transmit window */
+	IF_ENABLED(CONFIG_APP_TXWIN, (app_txwin_init();));
+
 	/* Create and start a Golioth Client */
 	client = golioth_client_create(client_config);
 
+	/* Set Golioth Client for the uplink scheduler */
+	app_uplink_set_client(client);
+
+	/* Apply scripted connectivity loss of simulated fleet devices */
+	IF_ENABLED(CONFIG_APP_FLEET_SIM, (app_fleet_sim_set_client(client);));
+
 	/* Register Golioth on_connect callback */
 	golioth_client_register_event_callback(client, on_client_event, NULL);
 
 	/* Initialize DFU components */
 	golioth_fw_update_init(client, _current_version);
 
+	/* Reduce other traffic while firmware downloads */
+	app_ota_init();
+
 	/*** Call Golioth APIs for other services in dedicated app files ***/
 
 	/* Observe State service data */
@@ -118,6 +149,22 @@ static void lte_handler(const struct lte_lc_evt *const evt)
 			}
 		}
 	}
+
+	if ((evt->type == LTE_LC_EVT_RRC_UPDATE) && (evt->rrc_mode == LTE_LC_RRC_MODE_CONNECTED)) {
+		/* The radio is up anyway (e.g. a PSM tracking area update), send what is held */
+		IF_ENABLED(CONFIG_APP_TXWIN, (app_txwin_radio_active();));
+	}
+
+	if (evt->type == LTE_LC_EVT_PSM_UPDATE) {
+		LOG_INF("PSM: TAU %d s, active time %d s", evt->psm_cfg.tau,
+			evt->psm_cfg.active_time);
+	}
+
+	if (evt->type == LTE_LC_EVT_EDRX_UPDATE) {
+		LOG_INF("eDRX: cycle %d ms, paging time window %d ms",
+			(int)(evt->edrx_cfg.edrx * MSEC_PER_SEC),
+			(int)(evt->edrx_cfg.ptw * MSEC_PER_SEC));
+	}
 }
 
 #endif /* CONFIG_SOC_SERIES_NRF91X */
@@ -140,13 +187,19 @@ static void log_modem_firmware_version(void)
 }
 #endif
 
+static void button_work_handler(struct k_work *work)
+{
+	app_sensors_report_button();
+}
+K_WORK_DEFINE(button_work, button_work_handler);
+
 void button_pressed(const struct device *dev, struct gpio_callback *cb, uint32_t pins)
 {
 	LOG_DBG("Button pressed at %d", k_cycle_get_32());
 	/* This function is an Interrupt Service Routine. Do not call functions that
 	 * use other threads, or perform long-running operations here
 	 */
-	k_wakeup(_system_thread);
+	k_work_submit(&button_work);
 }
 
 /* Set (unset) LED indicators for active Golioth connection */
@@ -191,9 +244,6 @@ int main(void)
 		ostentus_show_splash(o_dev);
 	));
 
-	/* Get system thread id so loop delay change event can wake main */
-	_system_thread = k_current_get();
-
 #if DT_NODE_EXISTS(DT_ALIAS(golioth_led))
 	/* Initialize Golioth logo LED */
 	err = gpio_pin_configure_dt(&golioth_led, GPIO_OUTPUT_INACTIVE);
@@ -218,6 +268,12 @@ int main(void)
 		net_connect();
 	}
 
+	/* Apply per-instance options and start jitter of simulated fleet devices */
+	IF_ENABLED(CONFIG_APP_FLEET_SIM, (app_fleet_sim_init();));
+
+	/* Model radio states and charge of a cellular link */
+	IF_ENABLED(CONFIG_APP_LINK_SIM, (app_link_sim_init();));
+
 	/* Start Golioth client */
 	start_golioth_client();
 
@@ -275,8 +331,11 @@ int main(void)
 	));
 
 	while (true) {
-		app_sensors_read_and_stream();
+		const struct zbus_channel *chan;
+
+		app_sensors_read_and_publish();
 
-		k_sleep(K_SECONDS(get_loop_delay_s()));
+		/* Sleep for the loop delay, or until a setting changes or the button is pressed */
+		zbus_sub_wait(&main_sub, &chan, K_SECONDS(get_loop_delay_s()));
 	}
 }
@@ -0,0 +1,326 @@
+/*
+ * Copyright (c) 2026 Golioth, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <math.h>
+#include <string.h>
+#include <zcbor_decode.h>
+#include <zcbor_encode.h>
+#include <zephyr/ztest.h>
+
+#include "app_codec.h"
+#include "app_perf.h"
+
+#define BENCH_ITERATIONS 1000
+
+static uint8_t cbor[64];
+
+/* The Golioth SDK hands RPC handlers a decoder positioned inside the params array */
+#define PARAMS_DECODER(name, len)                                                                  \
+	ZCBOR_STATE_D(name, 2, cbor, len, 1, 0);                                                   \
+	zassert_true(zcbor_list_start_decode(name))
+
+static size_t params_encode_doubles(const double *values, size_t count)
+{
+	ZCBOR_STATE_E(zse, 1, cbor, sizeof(cbor), 1);
+
+	bool ok = zcbor_list_start_encode(zse, count);
+
+	for (size_t i = 0; ok && (i < count); i++) {
+		ok = zcbor_float64_put(zse, values[i]);
+	}
+
+	zassert_true(ok && zcbor_list_end_encode(zse, count));
+
+	return zse->payload - cbor;
+}
+
+static size_t params_encode_ints(const int32_t *values, size_t count)
+{
+	ZCBOR_STATE_E(zse, 1, cbor, sizeof(cbor), 1);
+
+	bool ok = zcbor_list_start_encode(zse, count);
+
+	for (size_t i = 0; ok && (i < count); i++) {
+		ok = zcbor_int32_put(zse, values[i]);
+	}
+
+	zassert_true(ok && zcbor_list_end_encode(zse, count));
+
+	return zse->payload - cbor;
+}
+
+static int desired_decode(const char *json, struct app_codec_desired *desired)
+{
+	char buf[128];
+
+	strcpy(buf, json);
+
+	return app_codec_desired_decode((const uint8_t *)buf, strlen(buf), desired);
+}
+
+ZTEST_SUITE(codec_desired, NULL, NULL, NULL, NULL, NULL);
+
+ZTEST(codec_desired, test_valid)
+{
+	struct app_codec_desired desired;
+
+	zassert_ok(desired_decode("{\"example_int0\":0,\"example_int1\":65535}", &desired));
+	zassert_equal(desired.present, APP_CODEC_DESIRED_INT0 | APP_CODEC_DESIRED_INT1);
+	zassert_equal(desired.processed, desired.present);
+	zassert_equal(desired.valid, desired.present);
+	zassert_equal(desired.example_int0, 0);
+	zassert_equal(desired.example_int1, 65535);
+}
+
+ZTEST(codec_desired, test_no_change)
+{
+	struct app_codec_desired desired;
+
+	zassert_ok(desired_decode("{\"example_int0\":-1,\"example_int1\":7}", &desired));
+	zassert_equal(desired.present, APP_CODEC_DESIRED_INT0 | APP_CODEC_DESIRED_INT1);
+	zassert_equal(desired.processed, APP_CODEC_DESIRED_INT1);
+	zassert_equal(desired.valid, APP_CODEC_DESIRED_INT1);
+	zassert_equal(desired.example_int1, 7);
+}
+
+ZTEST(codec_desired, test_out_of_range)
+{
+	struct app_codec_desired desired;
+
+	zassert_ok(desired_decode("{\"example_int0\":65536,\"example_int1\":-2}", &desired));
+	zassert_equal(desired.processed, APP_CODEC_DESIRED_INT0 | APP_CODEC_DESIRED_INT1);
+	zassert_equal(desired.valid, 0);
+}
+
+ZTEST(codec_desired, test_partial)
+{
+	struct app_codec_desired desired;
+
+	zassert_ok(desired_decode("{\"example_int1\":3}", &desired));
+	zassert_equal(desired.present, APP_CODEC_DESIRED_INT1);
+	zassert_equal(desired.valid, APP_CODEC_DESIRED_INT1);
+
+	zassert_ok(desired_decode("{}", &desired));
+	zassert_equal(desired.present, 0);
+	zassert_equal(desired.processed, 0);
+}
+
+ZTEST(codec_desired, test_malformed)
+{
+	struct app_codec_desired desired;
+
+	zassert_true(desired_decode("", &desired) < 0);
+	zassert_true(desired_decode("{\"example_int0\":", &desired) < 0);
+	zassert_true(desired_decode("{\"example_int0\":\"1\"}", &desired) < 0);
+	zassert_true(desired_decode("[1,2]", &desired) < 0);
+}
+
+ZTEST_SUITE(codec_settings, NULL, NULL, NULL, NULL, NULL);
+
+ZTEST(codec_settings, test_loop_delay)
+{
+	zassert_ok(app_codec_loop_delay_check(APP_CODEC_LOOP_DELAY_S_MIN));
+	zassert_ok(app_codec_loop_delay_check(60));
+	zassert_ok(app_codec_loop_delay_check(APP_CODEC_LOOP_DELAY_S_MAX));
+	zassert_equal(app_codec_loop_delay_check(0), -ERANGE);
+	zassert_equal(app_codec_loop_delay_check(-60), -ERANGE);
+	zassert_equal(app_codec_loop_delay_check(APP_CODEC_LOOP_DELAY_S_MAX + 1), -ERANGE);
+	zassert_equal(app_codec_loop_delay_check(INT32_MIN), -ERANGE);
+}
+
+ZTEST_SUITE(codec_rpc, NULL, NULL, NULL, NULL, NULL);
+
+ZTEST(codec_rpc, test_log_level)
+{
+	const double values[] = {3.0};
+	size_t len = params_encode_doubles(values, ARRAY_SIZE(values));
+	uint8_t level;
+
+	PARAMS_DECODER(zsd, len);
+
+	zassert_ok(app_codec_log_level_decode(zsd, &level));
+	zassert_equal(level, 3);
+}
+
+ZTEST(codec_rpc, test_log_level_out_of_range)
+{
+	const double values[] = {-1.0, 4.5, NAN, INFINITY, 1e300};
+	uint8_t level;
+
+	for (size_t i = 0; i < ARRAY_SIZE(values); i++) {
+		size_t len = params_encode_doubles(&values[i], 1);
+
+		PARAMS_DECODER(zsd, len);
+
+		zassert_equal(app_codec_log_level_decode(zsd, &level), -ERANGE, "value %zu", i);
+	}
+}
+
+ZTEST(codec_rpc, test_log_level_malformed)
+{
+	const int32_t values[] = {3};
+	size_t len = params_encode_ints(values, ARRAY_SIZE(values));
+	uint8_t level;
+
+	PARAMS_DECODER(zsd, len);
+
+	/* Only floats are accepted, as sent by the Golioth console */
+	zassert_equal(app_codec_log_level_decode(zsd, &level), -EBADMSG);
+
+	len = params_encode_ints(values, 0);
+
+	PARAMS_DECODER(empty, len);
+
+	zassert_equal(app_codec_log_level_decode(empty, &level), -EBADMSG);
+}
+
+ZTEST(codec_rpc, test_capture)
+{
+	const int32_t ints[] = {10, 100};
+	const double floats[] = {2.0, 1000.0};
+	uint32_t duration_s;
+	uint32_t rate_hz;
+	size_t len;
+
+	len = params_encode_ints(ints, ARRAY_SIZE(ints));
+	PARAMS_DECODER(zsd_ints, len);
+	zassert_ok(app_codec_capture_decode(zsd_ints, &duration_s, &rate_hz));
+	zassert_equal(duration_s, 10);
+	zassert_equal(rate_hz, 100);
+
+	len = params_encode_doubles(floats, ARRAY_SIZE(floats));
+	PARAMS_DECODER(zsd_floats, len);
+	zassert_ok(app_codec_capture_decode(zsd_floats, &duration_s, &rate_hz));
+	zassert_equal(duration_s, 2);
+	zassert_equal(rate_hz, 1000);
+}
+
+ZTEST(codec_rpc, test_capture_invalid)
+{
+	const int32_t zero[] = {0, 100};
+	const int32_t large[] = {10, 70000};
+	const double nan[] = {NAN, 100.0};
+	const int32_t missing[] = {10};
+	uint32_t duration_s;
+	uint32_t rate_hz;
+	size_t len;
+
+	len = params_encode_ints(zero, ARRAY_SIZE(zero));
+	PARAMS_DECODER(zsd_zero, len);
+	zassert_equal(app_codec_capture_decode(zsd_zero, &duration_s, &rate_hz), -ERANGE);
+
+	len = params_encode_ints(large, ARRAY_SIZE(large));
+	PARAMS_DECODER(zsd_large, len);
+	zassert_equal(app_codec_capture_decode(zsd_large, &duration_s, &rate_hz), -ERANGE);
+
+	len = params_encode_doubles(nan, ARRAY_SIZE(nan));
+	PARAMS_DECODER(zsd_nan, len);
+	zassert_equal(app_codec_capture_decode(zsd_nan, &duration_s, &rate_hz), -ERANGE);
+
+	len = params_encode_ints(missing, ARRAY_SIZE(missing));
+	PARAMS_DECODER(zsd_missing, len);
+	zassert_equal(app_codec_capture_decode(zsd_missing, &duration_s, &rate_hz), -EBADMSG);
+}
+
+ZTEST_SUITE(codec_encode, NULL, NULL, NULL, NULL, NULL);
+
+ZTEST(codec_encode, test_sample)
+{
+	const uint8_t expected[] = {0xa1, 0x67, 'c', 'o', 'u', 'n', 't', 'e', 'r', 0x18, 0x2a};
+	uint8_t buf[13];
+	size_t len;
+
+	zassert_ok(app_codec_sample_encode("counter", 42, buf, sizeof(buf), &len));
+	zassert_equal(len, sizeof(expected));
+	zassert_mem_equal(buf, expected, len);
+
+	zassert_equal(app_codec_sample_encode("counter", 42, buf, 8, &len), -ENOMEM);
+}
+
+ZTEST(codec_encode, test_age)
+{
+	uint8_t buf[16];
+	uint32_t age;
+	size_t offset;
+
+	ZCBOR_STATE_E(zse, 1, buf, sizeof(buf), 1);
+
+	zassert_true(zcbor_map_start_encode(zse, 1) && zcbor_tstr_put_lit(zse, "age_s"));
+	offset = zse->payload - buf;
+	zassert_true(app_codec_age_put(zse, 3));
+	zassert_true(zcbor_map_end_encode(zse, 1));
+
+	size_t len = zse->payload - buf;
+
+	zassert_ok(app_codec_age_add(buf, len, offset, 70000));
+
+	/* Still a valid map holding the advanced age */
+	ZCBOR_STATE_D(zsd, 1, buf, len, 1, 0);
+
+	zassert_true(zcbor_map_start_decode(zsd) && zcbor_tstr_expect_lit(zsd, "age_s") &&
+		     zcbor_uint32_decode(zsd, &age) && zcbor_map_end_decode(zsd));
+	zassert_equal(age, 70003);
+
+	zassert_equal(app_codec_age_add(buf, len, 0, 1), -EINVAL);
+	zassert_equal(app_codec_age_add(buf, offset + 2, offset, 1), -EINVAL);
+
+	ZCBOR_STATE_E(zse_small, 1, buf, 4, 1);
+
+	zassert_false(app_codec_age_put(zse_small, 3));
+}
+
+ZTEST(codec_encode, test_state)
+{
+	char buf[APP_CODEC_STATE_MAX_LEN];
+
+	zassert_equal(app_codec_state_format(buf, sizeof(buf), 0, 1), 36);
+	zassert_equal(strcmp(buf, "{\"example_int0\":0,\"example_int1\":1}"), 0);
+
+	zassert_true(app_codec_state_format(buf, sizeof(buf), INT32_MIN, INT32_MIN) > 0);
+	zassert_equal(app_codec_state_format(buf, 16, 0, 1), -ENOMEM);
+}
+
+/* Each case runs one hot path and reports it through the APP_PERF probes */
+ZTEST_SUITE(codec_bench, NULL, NULL, NULL, NULL, NULL);
+
+ZTEST(codec_bench, test_bench)
+{
+	const double log_level[] = {3.0};
+	const int32_t capture[] = {10, 100};
+	struct app_codec_desired desired;
+	char state[APP_CODEC_STATE_MAX_LEN];
+	uint8_t sample[13];
+	size_t len;
+
+	for (int i = 0; i < BENCH_ITERATIONS; i++) {
+		zassert_ok(app_codec_sample_encode("counter", i, sample, sizeof(sample), &len));
+		zassert_true(app_codec_state_format(state, sizeof(state), i, -i) > 0);
+		zassert_ok(desired_decode("{\"example_int0\":1234,\"example_int1\":-1}", &desired));
+	}
+
+	len = params_encode_doubles(log_level, ARRAY_SIZE(log_level));
+
+	for (int i = 0; i < BENCH_ITERATIONS; i++) {
+		uint8_t level;
+
+		PARAMS_DECODER(zsd, len);
+		zassert_ok(app_codec_log_level_decode(zsd, &level));
+	}
+
+	len = params_encode_ints(capture, ARRAY_SIZE(capture));
+
+	for (int i = 0; i < BENCH_ITERATIONS; i++) {
+		uint32_t duration_s;
+		uint32_t rate_hz;
+
+		PARAMS_DECODER(zsd, len);
+		zassert_ok(app_codec_capture_decode(zsd, &duration_s, &rate_hz));
+	}
+
+	/* One JSON object per probe, collected by CI from the console */
+	app_perf_report();
+}
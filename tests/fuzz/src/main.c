@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2026 Golioth, Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/** libFuzzer harness for the desired state and RPC parameter decoders.
+ *
+ * The first byte of each input selects the decoder, the rest is its payload:
+ *
+ * - `0`: desired state JSON (`app_codec_desired_decode()`)
+ * - `1`: `set_log_level` parameters, a CBOR array (`app_codec_log_level_decode()`)
+ * - `2`: `start_capture` parameters, a CBOR array (`app_codec_capture_decode()`)
+ *
+ * Besides crashes and sanitizer findings, the decoders' guarantees on their
+ * results are asserted. Seed inputs are in `corpus/`.
+ */
+
+#include <string.h>
+#include <zcbor_decode.h>
+#include <zephyr/irq.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <irq_ctrl.h>
+#include <nsi_cpu_if.h>
+#include <nsi_main_semipublic.h>
+
+#include "app_codec.h"
+
+enum fuzz_target {
+	FUZZ_DESIRED,
+	FUZZ_LOG_LEVEL,
+	FUZZ_CAPTURE,
+};
+
+static const uint8_t *fuzz_buf;
+static size_t fuzz_sz;
+
+static K_SEM_DEFINE(fuzz_sem, 0, K_SEM_MAX_LIMIT);
+
+static void fuzz_desired(const uint8_t *data, size_t len)
+{
+	static char json[1024];
+	struct app_codec_desired desired;
+
+	if (len > sizeof(json)) {
+		return;
+	}
+
+	/* The JSON parser takes a mutable buffer */
+	memcpy(json, data, len);
+
+	if (app_codec_desired_decode((const uint8_t *)json, len, &desired) < 0) {
+		return;
+	}
+
+	__ASSERT_NO_MSG((desired.processed & ~desired.present) == 0);
+	__ASSERT_NO_MSG((desired.valid & ~desired.processed) == 0);
+
+	if (desired.valid & APP_CODEC_DESIRED_INT0) {
+		__ASSERT_NO_MSG((desired.example_int0 >= 0) && (desired.example_int0 < 65536));
+	}
+
+	if (desired.valid & APP_CODEC_DESIRED_INT1) {
+		__ASSERT_NO_MSG((desired.example_int1 >= 0) && (desired.example_int1 < 65536));
+	}
+}
+
+static void fuzz_rpc(enum fuzz_target target, const uint8_t *data, size_t len)
+{
+	ZCBOR_STATE_D(zsd, 2, data, len, 1, 0);
+	uint32_t duration_s;
+	uint32_t rate_hz;
+	uint8_t level;
+
+	/* The Golioth SDK hands RPC handlers a decoder positioned inside the params array */
+	if (!zcbor_list_start_decode(zsd)) {
+		return;
+	}
+
+	if (target == FUZZ_LOG_LEVEL) {
+		if (app_codec_log_level_decode(zsd, &level) == 0) {
+			__ASSERT_NO_MSG(level <= LOG_LEVEL_DBG);
+		}
+	} else if (app_codec_capture_decode(zsd, &duration_s, &rate_hz) == 0) {
+		__ASSERT_NO_MSG((duration_s >= 1) && (duration_s <= UINT16_MAX));
+		__ASSERT_NO_MSG((rate_hz >= 1) && (rate_hz <= UINT16_MAX));
+	}
+}
+
+static void fuzz_one(const uint8_t *data, size_t len)
+{
+	if (len < 1) {
+		return;
+	}
+
+	switch (data[0]) {
+	case FUZZ_DESIRED:
+		fuzz_desired(data + 1, len - 1);
+		break;
+	case FUZZ_LOG_LEVEL:
+	case FUZZ_CAPTURE:
+		fuzz_rpc(data[0], data + 1, len - 1);
+		break;
+	default:
+		break;
+	}
+}
+
+static void fuzz_isr(const void *arg)
+{
+	/* Run the input on the main thread, like the decoders run on the client thread */
+	k_sem_give(&fuzz_sem);
+}
+
+int main(void)
+{
+	IRQ_CONNECT(CONFIG_ARCH_POSIX_FUZZ_IRQ, 0, fuzz_isr, NULL, 0);
+	irq_enable(CONFIG_ARCH_POSIX_FUZZ_IRQ);
+
+	while (true) {
+		k_sem_take(&fuzz_sem, K_FOREVER);
+		fuzz_one(fuzz_buf, fuzz_sz);
+	}
+
+	return 0;
+}
+
+/* libFuzzer entry point, hands each input to the embedded OS as an interrupt */
+NATIVE_SIMULATOR_IF int LLVMFuzzerTestOneInput(const uint8_t *data, size_t sz)
+{
+	static bool runner_initialized;
+
+	if (!runner_initialized) {
+		nsi_init(0, NULL);
+		runner_initialized = true;
+	}
+
+	fuzz_buf = data;
+	fuzz_sz = sz;
+	hw_irq_ctrl_set_irq(CONFIG_ARCH_POSIX_FUZZ_IRQ);
+
+	/* Let the OS handle the interrupt and become idle again */
+	nsi_exec_for(k_ticks_to_us_ceil64(CONFIG_ARCH_POSIX_FUZZ_TICKS));
+
+	return 0;
+}